@@ -28,30 +28,41 @@
 #include <QClipboard>
 #include <QColorDialog>
 #include <QComboBox>
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDBusConnection>
 #include <QDBusConnectionInterface>
 #include <QDBusInterface>
 #include <QDate>
 #include <QDesktopWidget>
 #include <QDialogButtonBox>
+#include <QDir>
 #include <QDoubleSpinBox>
 #include <QEvent>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QFileSystemWatcher>
 #include <QFontDialog>
 #include <QFormLayout>
+#include <QHash>
 #include <QHeaderView>
 #include <QIcon>
 #include <QInputDialog>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QKeyEvent>
 #include <QLineEdit>
 #include <QLocale>
 #include <QMenuBar>
 #include <QMessageBox>
+#include <QMouseEvent>
 #include <QProcess>
 #include <QProgressDialog>
 #include <QPropertyAnimation>
 #include <QPushButton>
-#include <QRadioButton>
+#include <QRunnable>
+#include <QSaveFile>
 #include <QScreen>
 #include <QScrollBar>
 #include <QSettings>
@@ -60,15 +71,20 @@
 #include <QSpinBox>
 #include <QStringBuilder>
 #include <QStringList>
+#include <QStyle>
+#include <QStyleOption>
 #include <QStyledItemDelegate>
 #include <QTabWidget>
 #include <QTextBrowser>
 #include <QTextCodec>
-#include <QThread>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QThreadPool>
 #include <QTimer>
 #include <QTimerEvent>
 #include <QTreeWidget>
 #include <QTreeWidgetItem>
+#include <QtEndian>
 
 #if QT_VERSION >= 0x050000
 // this is to hack access to the --title parameter in Qt5
@@ -77,13 +93,29 @@
 
 #include <QtDebug>
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
 #include <cfloat>
+#include <cstring>
+#include <functional>
 
 #ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
 #include <unistd.h>
 #endif
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 /******************************************************************************
  * define
  ******************************************************************************/
@@ -98,6 +130,169 @@
 #define SKIP_EMPTY QString::SkipEmptyParts
 #endif
 
+/*******************
+ * Options
+ *******************/
+
+// Options tested by readGeneral() and the show* parsers. Each argument is looked up once
+// (see optionFromArg()) and then dispatched on its id instead of string comparisons.
+// Every option must have its help (see optionsWithoutHelp()).
+#define GUID_OPTIONS(X)                                \
+	X(ActionAfterOkClick, "--action-after-ok-click")   \
+	X(AddCalendar, "--add-calendar")                   \
+	X(AddCheckbox, "--add-checkbox")                   \
+	X(AddCombo, "--add-combo")                         \
+	X(AddDoubleSpinBox, "--add-double-spin-box")       \
+	X(AddEntry, "--add-entry")                         \
+	X(AddFileSelection, "--add-file-selection")        \
+	X(AddHrule, "--add-hrule")                         \
+	X(AddHspacer, "--add-hspacer")                     \
+	X(AddList, "--add-list")                           \
+	X(AddMenu, "--add-menu")                           \
+	X(AddPassword, "--add-password")                   \
+	X(AddQrCode, "--add-qr-code")                      \
+	X(AddScale, "--add-scale")                         \
+	X(AddSpinBox, "--add-spin-box")                    \
+	X(AddText, "--add-text")                           \
+	X(AddTextBrowser, "--add-text-browser")            \
+	X(AddTextInfo, "--add-text-info")                  \
+	X(AddVspacer, "--add-vspacer")                     \
+	X(Align, "--align")                                \
+	X(AlwaysOnTop, "--always-on-top")                  \
+	X(Attach, "--attach")                              \
+	X(AutoClose, "--auto-close")                       \
+	X(AutoKill, "--auto-kill")                         \
+	X(AutoScroll, "--auto-scroll")                     \
+	X(BackgroundColor, "--background-color")           \
+	X(Bold, "--bold")                                  \
+	X(CancelLabel, "--cancel-label")                   \
+	X(Checkbox, "--checkbox")                          \
+	X(Checked, "--checked")                            \
+	X(Checklist, "--checklist")                        \
+	X(CloseToSystray, "--close-to-systray")            \
+	X(Col1, "--col1")                                  \
+	X(Col2, "--col2")                                  \
+	X(Color, "--color")                                \
+	X(Column, "--column")                              \
+	X(ColumnValues, "--column-values")                 \
+	X(ComboValues, "--combo-values")                   \
+	X(ComboValuesFromFile, "--combo-values-from-file") \
+	X(Comment, "--comment")                            \
+	X(ConfirmOverwrite, "--confirm-overwrite")         \
+	X(Control, "--control")                            \
+	X(CurlPath, "--curl-path")                         \
+	X(CustomPalette, "--custom-palette")               \
+	X(DateFormat, "--date-format")                     \
+	X(Day, "--day")                                    \
+	X(Decimals, "--decimals")                          \
+	X(DefaultCancel, "--default-cancel")               \
+	X(Directory, "--directory")                        \
+	X(Editable, "--editable")                          \
+	X(Ellipsize, "--ellipsize")                        \
+	X(EmitChanges, "--emit-changes")                   \
+	X(EntryText, "--entry-text")                       \
+	X(FieldHeight, "--field-height")                   \
+	X(FieldWidth, "--field-width")                     \
+	X(FileFilter, "--file-filter")                     \
+	X(FileSeparator, "--file-separator")               \
+	X(Filename, "--filename")                          \
+	X(Float, "--float")                                \
+	X(Font, "--font")                                  \
+	X(FontFamily, "--font-family")                     \
+	X(FontSize, "--font-size")                         \
+	X(FooterEntries, "--footer-entries")               \
+	X(FooterFromFile, "--footer-from-file")            \
+	X(FooterName, "--footer-name")                     \
+	X(ForegroundColor, "--foreground-color")           \
+	X(FormsAlign, "--forms-align")                     \
+	X(FormsDateFormat, "--forms-date-format")          \
+	X(Group, "--group")                                \
+	X(Header, "--header")                              \
+	X(Height, "--height")                              \
+	X(Hide, "--hide")                                  \
+	X(HideColumn, "--hide-column")                     \
+	X(HideHeader, "--hide-header")                     \
+	X(HideText, "--hide-text")                         \
+	X(HideValue, "--hide-value")                       \
+	X(Hint, "--hint")                                  \
+	X(Html, "--html")                                  \
+	X(IconName, "--icon-name")                         \
+	X(Imagelist, "--imagelist")                        \
+	X(Int, "--int")                                    \
+	X(Italics, "--italics")                            \
+	X(JobPolicy, "--job-policy")                       \
+	X(JobTimeout, "--job-timeout")                     \
+	X(KillJobsOnExit, "--kill-jobs-on-exit")           \
+	X(List, "--list")                                  \
+	X(ListRowSeparator, "--list-row-separator")        \
+	X(ListValues, "--list-values")                     \
+	X(ListValuesFromFile, "--list-values-from-file")   \
+	X(Listen, "--listen")                              \
+	X(MaxJobs, "--max-jobs")                           \
+	X(MaxLines, "--max-lines")                         \
+	X(MaxValue, "--max-value")                         \
+	X(MidSearch, "--mid-search")                       \
+	X(MinValue, "--min-value")                         \
+	X(Modal, "--modal")                                \
+	X(Month, "--month")                                \
+	X(Multiple, "--multiple")                          \
+	X(NewlineSeparator, "--newline-separator")         \
+	X(NoBold, "--no-bold")                             \
+	X(NoCancel, "--no-cancel")                         \
+	X(NoInteraction, "--no-interaction")               \
+	X(NoMarkup, "--no-markup")                         \
+	X(NoSelection, "--no-selection")                   \
+	X(NoTaskbar, "--no-taskbar")                       \
+	X(NoWrap, "--no-wrap")                             \
+	X(OkLabel, "--ok-label")                           \
+	X(OutputFormat, "--output-format")                 \
+	X(OutputPrefixErr, "--output-prefix-err")          \
+	X(OutputPrefixOk, "--output-prefix-ok")            \
+	X(Pattern, "--pattern")                            \
+	X(Percentage, "--percentage")                      \
+	X(Plain, "--plain")                                \
+	X(PollInterval, "--poll-interval")                 \
+	X(Prefix, "--prefix")                              \
+	X(PrintColumn, "--print-column")                   \
+	X(PrintPartial, "--print-partial")                 \
+	X(PrintValues, "--print-values")                   \
+	X(Prompt, "--prompt")                              \
+	X(Pulsate, "--pulsate")                            \
+	X(Radiolist, "--radiolist")                        \
+	X(ReadOnlyColumn, "--read-only-column")            \
+	X(Sample, "--sample")                              \
+	X(Save, "--save")                                  \
+	X(SelectableLabels, "--selectable-labels")         \
+	X(Separator, "--separator")                        \
+	X(ShowHeader, "--show-header")                     \
+	X(ShowPalette, "--show-palette")                   \
+	X(SmallCaps, "--small-caps")                       \
+	X(Stats, "--stats")                                \
+	X(Step, "--step")                                  \
+	X(Suffix, "--suffix")                              \
+	X(SystrayIcon, "--systray-icon")                   \
+	X(Tab, "--tab")                                    \
+	X(TabVisible, "--tab-visible")                     \
+	X(Text, "--text")                                  \
+	X(TimeRemaining, "--time-remaining")               \
+	X(Timeout, "--timeout")                            \
+	X(Title, "--title")                                \
+	X(Tooltip, "--tooltip")                            \
+	X(Type, "--type")                                  \
+	X(Underline, "--underline")                        \
+	X(Url, "--url")                                    \
+	X(Username, "--username")                          \
+	X(Valign, "--valign")                              \
+	X(Value, "--value")                                \
+	X(Values, "--values")                              \
+	X(Var, "--var")                                    \
+	X(Width, "--width")                                \
+	X(WinMaxButton, "--win-max-button")                \
+	X(WinMinButton, "--win-min-button")                \
+	X(WindowIcon, "--window-icon")                     \
+	X(Wrap, "--wrap")                                  \
+	X(Year, "--year")
+
 /*******************
  * Output
  *******************/
@@ -175,110 +370,37 @@
  * Forms
  *******************/
 
-#define SET_WIDGET_SETTINGS(ARG)                                      \
-	ws = WidgetSettings();                                            \
-	next_arg_split = next_arg.split('@');                             \
-	foreach (QString setting, next_arg_split) {                       \
-		if (setting.startsWith("addLabel="))                          \
-			ws.addLabel = getWidgetSettingQString(setting);           \
-		else if (setting.startsWith("addNewRowButton="))              \
-			ws.addNewRowButton = getWidgetSettingBool(setting);       \
-		else if (setting.startsWith("backgroundColor="))              \
-			ws.backgroundColor = getWidgetSettingQString(setting);    \
-		else if (setting.startsWith("buttonText="))                   \
-			ws.buttonText = getWidgetSettingQString(setting);         \
-		else if (setting.startsWith("command="))                      \
-			ws.command = getWidgetSettingQString(setting);            \
-		else if (setting.startsWith("commandToFooter="))              \
-			ws.commandToFooter = getWidgetSettingBool(setting);       \
-		else if (setting.startsWith("defaultIndex="))                 \
-			ws.defaultIndex = getWidgetSettingInt(setting);           \
-		else if (setting.startsWith("defMarkerVal1="))                \
-			ws.defMarkerVal1 = getWidgetSettingQString(setting);      \
-		else if (setting.startsWith("defMarkerVal2="))                \
-			ws.defMarkerVal2 = getWidgetSettingQString(setting);      \
-		else if (setting.startsWith("defMarkerVal3="))                \
-			ws.defMarkerVal3 = getWidgetSettingQString(setting);      \
-		else if (setting.startsWith("defMarkerVal4="))                \
-			ws.defMarkerVal4 = getWidgetSettingQString(setting);      \
-		else if (setting.startsWith("defMarkerVal5="))                \
-			ws.defMarkerVal5 = getWidgetSettingQString(setting);      \
-		else if (setting.startsWith("defMarkerVal6="))                \
-			ws.defMarkerVal6 = getWidgetSettingQString(setting);      \
-		else if (setting.startsWith("defMarkerVal7="))                \
-			ws.defMarkerVal7 = getWidgetSettingQString(setting);      \
-		else if (setting.startsWith("defMarkerVal8="))                \
-			ws.defMarkerVal8 = getWidgetSettingQString(setting);      \
-		else if (setting.startsWith("defMarkerVal9="))                \
-			ws.defMarkerVal9 = getWidgetSettingQString(setting);      \
-		else if (setting.startsWith("disableButtons="))               \
-			ws.disableButtons = getWidgetSettingBool(setting);        \
-		else if (setting.startsWith("excludeFromOutput="))            \
-			ws.excludeFromOutput = getWidgetSettingBool(setting);     \
-		else if (setting.startsWith("foregroundColor="))              \
-			ws.foregroundColor = getWidgetSettingQString(setting);    \
-		else if (setting.startsWith("hideLabel="))                    \
-			ws.hideLabel = getWidgetSettingBool(setting);             \
-		else if (setting.startsWith("image="))                        \
-			ws.image = getWidgetSettingQString(setting);              \
-		else if (setting.startsWith("keepOpen="))                     \
-			ws.keepOpen = getWidgetSettingBool(setting);              \
-		else if (setting.startsWith("monitor="))                      \
-			ws.monitorFile = getWidgetSettingBool(setting);           \
-		else if (setting.startsWith("monitorMarkerFile1="))           \
-			ws.monitorMarkerFile1 = getWidgetSettingQString(setting); \
-		else if (setting.startsWith("monitorMarkerFile2="))           \
-			ws.monitorMarkerFile2 = getWidgetSettingQString(setting); \
-		else if (setting.startsWith("monitorMarkerFile3="))           \
-			ws.monitorMarkerFile3 = getWidgetSettingQString(setting); \
-		else if (setting.startsWith("monitorMarkerFile4="))           \
-			ws.monitorMarkerFile4 = getWidgetSettingQString(setting); \
-		else if (setting.startsWith("monitorMarkerFile5="))           \
-			ws.monitorMarkerFile5 = getWidgetSettingQString(setting); \
-		else if (setting.startsWith("monitorMarkerFile6="))           \
-			ws.monitorMarkerFile6 = getWidgetSettingQString(setting); \
-		else if (setting.startsWith("monitorMarkerFile7="))           \
-			ws.monitorMarkerFile7 = getWidgetSettingQString(setting); \
-		else if (setting.startsWith("monitorMarkerFile8="))           \
-			ws.monitorMarkerFile8 = getWidgetSettingQString(setting); \
-		else if (setting.startsWith("monitorMarkerFile9="))           \
-			ws.monitorMarkerFile9 = getWidgetSettingQString(setting); \
-		else if (setting.startsWith("monitorVarName1="))              \
-			ws.monitorVarName1 = getWidgetSettingQString(setting);    \
-		else if (setting.startsWith("monitorVarName2="))              \
-			ws.monitorVarName2 = getWidgetSettingQString(setting);    \
-		else if (setting.startsWith("monitorVarName3="))              \
-			ws.monitorVarName3 = getWidgetSettingQString(setting);    \
-		else if (setting.startsWith("monitorVarName4="))              \
-			ws.monitorVarName4 = getWidgetSettingQString(setting);    \
-		else if (setting.startsWith("monitorVarName5="))              \
-			ws.monitorVarName5 = getWidgetSettingQString(setting);    \
-		else if (setting.startsWith("monitorVarName6="))              \
-			ws.monitorVarName6 = getWidgetSettingQString(setting);    \
-		else if (setting.startsWith("monitorVarName7="))              \
-			ws.monitorVarName7 = getWidgetSettingQString(setting);    \
-		else if (setting.startsWith("monitorVarName8="))              \
-			ws.monitorVarName8 = getWidgetSettingQString(setting);    \
-		else if (setting.startsWith("monitorVarName9="))              \
-			ws.monitorVarName9 = getWidgetSettingQString(setting);    \
-		else if (setting.startsWith("selected="))                     \
-			ws.selected = getWidgetSettingBool(setting);              \
-		else if (setting.startsWith("sep="))                          \
-			ws.sep = getWidgetSettingQString(setting);                \
-		else if (setting.startsWith("size="))                         \
-			ws.size = getWidgetSettingInt(setting);                   \
-		else if (setting.startsWith("stop="))                         \
-			ws.stop = getWidgetSettingBool(setting);                  \
-		else if (setting.startsWith("valuesToFooter="))               \
-			ws.valuesToFooter = getWidgetSettingBool(setting);        \
-		else if (setting.startsWith("verboseTabBar="))                \
-			ws.verboseTabBar = getWidgetSettingBool(setting);         \
-		else                                                          \
-			next_arg_join << setting;                                 \
-	}                                                                 \
-	next_arg = next_arg_join.join('@');                               \
-	next_arg_split.clear();                                           \
-	next_arg_join.clear();
+// Keys of the "key=value" widget settings that can follow an --add-* argument, separated by "@".
+// The marker keys take their number as a suffix (e.g. monitorMarkerFile12).
+#define WIDGET_SETTINGS(X)                    \
+	X(AddLabel, "addLabel")                   \
+	X(AddNewRowButton, "addNewRowButton")     \
+	X(BackgroundColor, "backgroundColor")     \
+	X(ButtonText, "buttonText")               \
+	X(Command, "command")                     \
+	X(CommandToFooter, "commandToFooter")     \
+	X(DefaultIndex, "defaultIndex")           \
+	X(DefMarkerVal, "defMarkerVal")           \
+	X(DisableButtons, "disableButtons")       \
+	X(ExcludeFromOutput, "excludeFromOutput") \
+	X(Follow, "follow")                       \
+	X(ForegroundColor, "foregroundColor")     \
+	X(HideLabel, "hideLabel")                 \
+	X(Image, "image")                         \
+	X(KeepOpen, "keepOpen")                   \
+	X(Monitor, "monitor")                     \
+	X(MonitorMarkerFile, "monitorMarkerFile") \
+	X(MonitorVarName, "monitorVarName")       \
+	X(Poll, "poll")                           \
+	X(Selected, "selected")                   \
+	X(Sep, "sep")                             \
+	X(Size, "size")                           \
+	X(Stop, "stop")                           \
+	X(ValuesToFooter, "valuesToFooter")       \
+	X(VerboseTabBar, "verboseTabBar")
+
+#define SET_WIDGET_SETTINGS(ARG) \
+	ws = parseWidgetSettings(ARG);
 
 #define SWITCH_FORM_WIDGET(NEW_WIDGET)                      \
 	if (lastWidgetId == "text-browser")                     \
@@ -286,7 +408,7 @@
 	else if (lastWidgetId == "text-info")                   \
 		setTextInfo(lastTextInfo);                          \
 	if (!lastWidgetVar.isEmpty() && lastWidget)             \
-		lastWidget->setProperty("guid_var", lastWidgetVar); \
+		editMeta(lastWidget).var = lastWidgetVar;           \
 	lastWidgetId = NEW_WIDGET;
 
 #define SET_FORMS_MENU_ITEM_DATA                                                                                 \
@@ -329,8 +451,7 @@
 		col1VAlignFlag = Qt::AlignTop;                                                               \
 		col2VAlignFlag = Qt::AlignTop;                                                               \
 		columnsContainer = new QWidget();                                                            \
-		columnsContainer->setProperty("guid_cols_container", true);                                  \
-		columnsContainer->setProperty("guid_separator", dlg->property("guid_separator").toString()); \
+		editMeta(columnsContainer).container = WidgetMeta::ColumnsContainer;                         \
 		columnsLayout->setContentsMargins(0, 1, 0, 0);                                               \
 		columnsContainer->setLayout(columnsLayout);                                                  \
 		if (!lastGroupName.isEmpty()) {                                                              \
@@ -498,16 +619,544 @@ public:
 
 // End of "class ReadOnlyColumn"
 
+/******************************************************************************
+ * class SelectionColumn
+ ******************************************************************************/
+
+// First column of a check/radio list. The state of each row is kept in
+// Qt::CheckStateRole and its indicator is painted here, centered, instead of
+// using a QCheckBox or QRadioButton widget per row.
+class SelectionColumn : public ReadOnlyColumn {
+public:
+	SelectionColumn(bool radio, QObject* parent = 0)
+	    : ReadOnlyColumn(parent)
+	    , m_radio(radio) { }
+	virtual void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+		QStyleOptionViewItem opt = option;
+		initStyleOption(&opt, index);
+		const QWidget* widget = opt.widget;
+		QStyle* style = widget ? widget->style() : QApplication::style();
+
+		// Background, selection and focus
+		opt.features &= ~QStyleOptionViewItem::HasCheckIndicator;
+		opt.text.clear();
+		style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+		QStyleOptionButton button;
+		button.direction = opt.direction;
+		button.palette = opt.palette;
+		button.state = opt.state & QStyle::State_Enabled;
+		button.state |= index.data(Qt::CheckStateRole).toInt() == Qt::Checked ? QStyle::State_On : QStyle::State_Off;
+		QSize size;
+		if (m_radio)
+			size = QSize(style->pixelMetric(QStyle::PM_ExclusiveIndicatorWidth, &button, widget),
+			    style->pixelMetric(QStyle::PM_ExclusiveIndicatorHeight, &button, widget));
+		else
+			size = QSize(style->pixelMetric(QStyle::PM_IndicatorWidth, &button, widget),
+			    style->pixelMetric(QStyle::PM_IndicatorHeight, &button, widget));
+		button.rect = QStyle::alignedRect(opt.direction, Qt::AlignCenter, size, opt.rect);
+		style->drawPrimitive(m_radio ? QStyle::PE_IndicatorRadioButton : QStyle::PE_IndicatorCheckBox, &button, painter, widget);
+	}
+	virtual bool editorEvent(QEvent* event, QAbstractItemModel* model, const QStyleOptionViewItem& option, const QModelIndex& index) {
+		if (!(index.flags() & Qt::ItemIsEnabled) || !index.data(Qt::CheckStateRole).isValid())
+			return false;
+
+		if (event->type() == QEvent::MouseButtonRelease) {
+			QMouseEvent* mouseEvent = static_cast<QMouseEvent*>(event);
+			if (mouseEvent->button() != Qt::LeftButton || !option.rect.contains(mouseEvent->pos()))
+				return false;
+		} else if (event->type() == QEvent::MouseButtonDblClick) {
+			return true;
+		} else if (event->type() == QEvent::KeyPress) {
+			int key = static_cast<QKeyEvent*>(event)->key();
+			if (key != Qt::Key_Space && key != Qt::Key_Select)
+				return false;
+		} else {
+			return false;
+		}
+
+		bool checked = index.data(Qt::CheckStateRole).toInt() == Qt::Checked;
+		if (!m_radio)
+			return model->setData(index, checked ? Qt::Unchecked : Qt::Checked, Qt::CheckStateRole);
+		if (checked)
+			return true;
+
+		for (int row = 0; row < model->rowCount(index.parent()); ++row) {
+			QModelIndex sibling = model->index(row, 0, index.parent());
+			if (sibling != index && sibling.data(Qt::CheckStateRole).toInt() == Qt::Checked)
+				model->setData(sibling, Qt::Unchecked, Qt::CheckStateRole);
+		}
+		return model->setData(index, Qt::Checked, Qt::CheckStateRole);
+	}
+
+private:
+	bool m_radio;
+};
+
+// End of "class SelectionColumn"
+
+/******************************************************************************
+ * class ProgressColumn
+ ******************************************************************************/
+
+// Progress column of --multi-progress. The percentage of each row is kept in
+// Qt::DisplayRole and painted as a progress bar, without a QProgressBar per row.
+class ProgressColumn : public ReadOnlyColumn {
+public:
+	ProgressColumn(QObject* parent = 0)
+	    : ReadOnlyColumn(parent) { }
+	virtual void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+		QStyleOptionViewItem opt = option;
+		initStyleOption(&opt, index);
+		const QWidget* widget = opt.widget;
+		QStyle* style = widget ? widget->style() : QApplication::style();
+
+		// Background
+		opt.text.clear();
+		style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+		QStyleOptionProgressBar bar;
+		bar.direction = opt.direction;
+		bar.palette = opt.palette;
+		bar.fontMetrics = opt.fontMetrics;
+		bar.state = (opt.state & QStyle::State_Enabled) | QStyle::State_Horizontal;
+		bar.rect = opt.rect.adjusted(2, 2, -2, -2);
+		bar.minimum = 0;
+		bar.maximum = 100;
+		bar.progress = index.data(Qt::DisplayRole).toInt();
+		bar.text = QString::number(bar.progress) + "%";
+		bar.textVisible = true;
+		bar.textAlignment = Qt::AlignCenter;
+		style->drawControl(QStyle::CE_ProgressBar, &bar, painter, widget);
+	}
+};
+
+// End of "class ProgressColumn"
+
+/******************************************************************************
+ * class FileParser
+ ******************************************************************************/
+
+static QStringList readValuesFile(const QString& filePath, const QString& fileSep, bool mapFile, FileSignature* signature = NULL, bool* changed = NULL);
+
+// Reads a monitored value file in the thread pool. The values are handed back to
+// Guid::fileParsed() in the GUI thread, unless a newer change of the file made the
+// widget's generation move on, in which case the work is dropped. The generation counter
+// itself is handed back too, so a widget created at the address of a deleted one does not
+// take its values. With a signature (lists), a file whose size, time or content did not
+// change is not parsed.
+class FileParser : public QRunnable {
+public:
+	FileParser(QObject* receiver, QObject* widget, const QString& filePath, const QString& fileSep,
+	    QSharedPointer<QAtomicInt> latest, int generation, const FileSignature* signature = NULL)
+	    : m_filePath(filePath)
+	    , m_fileSep(fileSep)
+	    , m_generation(generation)
+	    , m_hasSignature(signature)
+	    , m_latest(latest)
+	    , m_receiver(receiver)
+	    , m_signature(signature ? *signature : FileSignature())
+	    , m_widget(widget) { }
+	virtual void run() {
+		if (m_latest->loadAcquire() != m_generation)
+			return;
+		FileSignature signature = m_signature;
+		bool changed = true;
+		QStringList values = readValuesFile(m_filePath, m_fileSep, false, m_hasSignature ? &signature : NULL, &changed);
+		if (m_latest->loadAcquire() != m_generation)
+			return;
+		if (!changed && signature.size == m_signature.size && signature.modified == m_signature.modified)
+			return; // not even touched
+		QMetaObject::invokeMethod(m_receiver, "fileParsed", Qt::QueuedConnection, Q_ARG(QObject*, m_widget),
+		    Q_ARG(QSharedPointer<QAtomicInt>, m_latest), Q_ARG(int, m_generation), Q_ARG(FileSignature, signature), Q_ARG(bool, changed), Q_ARG(QStringList, values));
+	}
+
+private:
+	QString m_filePath;
+	QString m_fileSep;
+	int m_generation;
+	bool m_hasSignature;
+	QSharedPointer<QAtomicInt> m_latest;
+	QObject* m_receiver;
+	FileSignature m_signature;
+	QObject* m_widget;
+};
+
+// End of "class FileParser"
+
+/******************************************************************************
+ * class FilePoller
+ ******************************************************************************/
+
+// Checks a batch of polled files in the thread pool. The files whose modification
+// time or size changed since they were last checked are handed back to
+// Guid::filesPolled(). Only one batch runs at a time, so stamps is never shared.
+class FilePoller : public QRunnable {
+public:
+	FilePoller(QObject* receiver, const QStringList& filePaths, QSharedPointer<QHash<QString, QPair<qint64, qint64>>> stamps)
+	    : m_filePaths(filePaths)
+	    , m_receiver(receiver)
+	    , m_stamps(stamps) { }
+	virtual void run() {
+		QStringList changedFiles;
+		foreach (const QString& filePath, m_filePaths) {
+			QFileInfo fileInfo(filePath);
+			QPair<qint64, qint64> stamp(-1, -1);
+			if (fileInfo.exists())
+				stamp = qMakePair(fileInfo.lastModified().toMSecsSinceEpoch(), fileInfo.size());
+
+			QHash<QString, QPair<qint64, qint64>>::iterator it = m_stamps->find(filePath);
+			if (it == m_stamps->end()) {
+				m_stamps->insert(filePath, stamp);
+			} else if (it.value() != stamp) {
+				it.value() = stamp;
+				changedFiles << filePath;
+			}
+		}
+		QMetaObject::invokeMethod(m_receiver, "filesPolled", Qt::QueuedConnection, Q_ARG(QStringList, changedFiles));
+	}
+
+private:
+	QStringList m_filePaths;
+	QObject* m_receiver;
+	QSharedPointer<QHash<QString, QPair<qint64, qint64>>> m_stamps;
+};
+
+// End of "class FilePoller"
+
+/******************************************************************************
+ * class FormsSpecReader
+ ******************************************************************************/
+
+// Streams a JSON forms spec (--forms-spec) into the argument list that the
+// command line would give. Objects are read in document order, which
+// QJsonDocument does not preserve.
+class FormsSpecReader {
+public:
+	FormsSpecReader(QIODevice* device)
+	    : m_device(device)
+	    , m_line(1)
+	    , m_pos(0) { }
+	QString errorString() const {
+		return m_error;
+	}
+	bool read(QStringList& args) {
+		skipSpace();
+		if (peek() == '[') {
+			next();
+			skipSpace();
+			if (peek() == ']') {
+				next();
+			} else {
+				forever {
+					if (!readItem(args))
+						return false;
+					skipSpace();
+					const char c = next();
+					if (c == ']')
+						break;
+					if (c != ',')
+						return fail("expected ',' or ']'");
+					skipSpace();
+				}
+			}
+		} else if (!readItem(args)) {
+			return false;
+		}
+
+		skipSpace();
+		if (!atEnd())
+			return fail("unexpected data after the spec");
+		return true;
+	}
+
+private:
+	bool atEnd() {
+		return peek() == '\0' && m_buffer.isEmpty();
+	}
+	bool fail(const QString& message) {
+		if (m_error.isEmpty())
+			m_error = QString("line %1: %2").arg(m_line).arg(message);
+		return false;
+	}
+	char next() {
+		const char c = peek();
+		if (c != '\0')
+			++m_pos;
+		if (c == '\n')
+			++m_line;
+		return c;
+	}
+	char peek() {
+		if (m_pos >= m_buffer.size()) {
+			m_buffer = m_device->read(64 * 1024);
+			m_pos = 0;
+			if (m_buffer.isEmpty())
+				return '\0';
+		}
+		return m_buffer.at(m_pos);
+	}
+	void skipSpace() {
+		forever {
+			const char c = peek();
+			if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+				break;
+			next();
+		}
+	}
+
+	// An item is "--option", or an object whose members are options in order
+	bool readItem(QStringList& args) {
+		if (peek() == '"') {
+			QString name;
+			if (!readString(name))
+				return false;
+			args << optionName(name);
+			return true;
+		}
+		if (next() != '{')
+			return fail("expected an option name or an object");
+
+		skipSpace();
+		if (peek() == '}') {
+			next();
+			return true;
+		}
+		forever {
+			skipSpace();
+			QString name;
+			if (!readString(name))
+				return false;
+			skipSpace();
+			if (next() != ':')
+				return fail("expected ':'");
+			skipSpace();
+			if (!readOptionValue(optionName(name), args))
+				return false;
+			skipSpace();
+			const char c = next();
+			if (c == '}')
+				return true;
+			if (c != ',')
+				return fail("expected ',' or '}'");
+		}
+	}
+
+	// true: flag; false or null: ignored; array: values joined with "|";
+	// object: widget settings joined with "@", ending with the "text" member
+	bool readOptionValue(const QString& option, QStringList& args) {
+		const char c = peek();
+		QString value;
+		bool isSet = true;
+
+		if (c == '[') {
+			next();
+			QStringList values;
+			skipSpace();
+			if (peek() == ']') {
+				next();
+			} else {
+				forever {
+					skipSpace();
+					QString item;
+					if (!readScalar(item, isSet))
+						return false;
+					values << item;
+					skipSpace();
+					const char end = next();
+					if (end == ']')
+						break;
+					if (end != ',')
+						return fail("expected ',' or ']'");
+				}
+			}
+			args << option << values.join('|');
+			return true;
+		}
+
+		if (c == '{') {
+			next();
+			QStringList settings;
+			QString text;
+			skipSpace();
+			if (peek() == '}') {
+				next();
+			} else {
+				forever {
+					skipSpace();
+					QString key;
+					if (!readString(key))
+						return false;
+					skipSpace();
+					if (next() != ':')
+						return fail("expected ':'");
+					skipSpace();
+					QString setting;
+					if (!readScalar(setting, isSet))
+						return false;
+					if (key == "text")
+						text = setting;
+					else
+						settings << key + "=" + setting;
+					skipSpace();
+					const char end = next();
+					if (end == '}')
+						break;
+					if (end != ',')
+						return fail("expected ',' or '}'");
+				}
+			}
+			settings << text;
+			args << option << settings.join('@');
+			return true;
+		}
+
+		if (!readScalar(value, isSet))
+			return false;
+		if (c == 't')
+			args << option;
+		else if (isSet && c != 'f')
+			args << option << value;
+		return true;
+	}
+
+	// Strings, numbers, true, false and null; null clears isSet
+	bool readScalar(QString& value, bool& isSet) {
+		isSet = true;
+		const char c = peek();
+		if (c == '"')
+			return readString(value);
+
+		QByteArray literal;
+		forever {
+			const char l = peek();
+			if (!((l >= 'a' && l <= 'z') || (l >= '0' && l <= '9') || l == '-' || l == '+' || l == '.' || l == 'E'))
+				break;
+			literal += next();
+		}
+		if (literal == "null") {
+			isSet = false;
+			value.clear();
+			return true;
+		}
+		bool ok = literal == "true" || literal == "false";
+		if (!ok)
+			literal.toDouble(&ok);
+		if (!ok)
+			return fail(literal.isEmpty() ? QString("expected a value") : "invalid value: " + QString::fromLatin1(literal));
+		value = QString::fromLatin1(literal);
+		return true;
+	}
+
+	bool readString(QString& value) {
+		if (next() != '"')
+			return fail("expected a string");
+
+		QByteArray utf8;
+		forever {
+			const char c = next();
+			if (c == '"')
+				break;
+			if (c == '\0')
+				return fail("unterminated string");
+			if (c != '\\') {
+				utf8 += c;
+				continue;
+			}
+
+			const char e = next();
+			switch (e) {
+			case '"':
+			case '\\':
+			case '/':
+				utf8 += e;
+				break;
+			case 'b':
+				utf8 += '\b';
+				break;
+			case 'f':
+				utf8 += '\f';
+				break;
+			case 'n':
+				utf8 += '\n';
+				break;
+			case 'r':
+				utf8 += '\r';
+				break;
+			case 't':
+				utf8 += '\t';
+				break;
+			case 'u': {
+				ushort code;
+				if (!readHex(code))
+					return false;
+				if (QChar::isHighSurrogate(code) && peek() == '\\') {
+					next();
+					ushort low;
+					if (next() != 'u' || !readHex(low) || !QChar::isLowSurrogate(low))
+						return fail("invalid surrogate pair");
+					const QChar pair[2] = { QChar(code), QChar(low) };
+					utf8 += QString(pair, 2).toUtf8();
+				} else {
+					utf8 += QString(QChar(code)).toUtf8();
+				}
+				break;
+			}
+			default:
+				return fail("invalid escape sequence");
+			}
+		}
+
+		value = QString::fromUtf8(utf8);
+		return true;
+	}
+
+	bool readHex(ushort& code) {
+		QByteArray hex;
+		for (int i = 0; i < 4; ++i)
+			hex += next();
+		bool ok;
+		code = hex.toUShort(&ok, 16);
+		return ok || fail("invalid \\u escape");
+	}
+
+	static QString optionName(const QString& name) {
+		return name.startsWith("--") ? name : "--" + name;
+	}
+
+private:
+	QByteArray m_buffer;
+	QIODevice* m_device;
+	QString m_error;
+	int m_line;
+	int m_pos;
+};
+
+// End of "class FormsSpecReader"
+
 /******************************************************************************
  * typedef
  ******************************************************************************/
 
-typedef QPair<bool, QString> ValuePair;
 typedef QPair<QString, QString> Help;
 typedef QList<Help> HelpList;
 typedef QPair<QString, HelpList> CategoryHelp;
 typedef QMap<QString, CategoryHelp> HelpDict;
 
+enum class WidgetSetting {
+	Unknown,
+#define WIDGET_SETTING_ID(id, key) id,
+	WIDGET_SETTINGS(WIDGET_SETTING_ID)
+#undef WIDGET_SETTING_ID
+};
+
+enum class Option {
+	Unknown,
+#define OPTION_ID(id, name) id,
+	GUID_OPTIONS(OPTION_ID)
+#undef OPTION_ID
+};
+
 // End of "typedef"
 
 /******************************************************************************
@@ -515,6 +1164,9 @@ typedef QMap<QString, CategoryHelp> HelpDict;
  ******************************************************************************/
 
 static QFile* gs_stdin = 0;
+static FormCache* gs_formCache = NULL; // set while a --form-cache form is built
+static QHash<QString, MarkerSource> gs_markerSources; // files of the monitorMarkerFileN markers
+static QHash<const QObject*, WidgetMeta> gs_widgetMeta; // see meta() and editMeta()
 
 // End of "static variables"
 
@@ -522,6 +1174,24 @@ static QFile* gs_stdin = 0;
  * static functions
  ******************************************************************************/
 
+// Settings of an object, or the defaults when none were set
+static const WidgetMeta& meta(const QObject* o) {
+	static const WidgetMeta defaults;
+	QHash<const QObject*, WidgetMeta>::const_iterator it = gs_widgetMeta.constFind(o);
+	return it == gs_widgetMeta.constEnd() ? defaults : it.value();
+}
+
+// Settings of an object, created on first use and dropped with the object. The
+// reference is invalidated by the next editMeta() call on another object.
+static WidgetMeta& editMeta(const QObject* o) {
+	QHash<const QObject*, WidgetMeta>::iterator it = gs_widgetMeta.find(o);
+	if (it == gs_widgetMeta.end()) {
+		it = gs_widgetMeta.insert(o, WidgetMeta());
+		QObject::connect(o, &QObject::destroyed, [o]() { gs_widgetMeta.remove(o); });
+	}
+	return it.value();
+}
+
 static QSize getQTreeWidgetSize(QTreeWidget** qtw) {
 	QTreeWidget* tw = *qtw;
 	int rows = 0;
@@ -562,8 +1232,9 @@ static QStringList addColumnToListValues(QStringList values, QString addValue, i
 }
 
 static void addItems(QTreeWidget* tw, QStringList& values, bool editable, bool checkable, bool icons) {
-	QString selectionType = tw->property("guid_list_selection_type").toString();
+	QString selectionType = meta(tw).listSelectionType;
 
+	QList<QTreeWidgetItem*> items;
 	for (int i = 0; i < values.count();) {
 		QStringList itemValues;
 		for (int j = 0; j < tw->columnCount(); ++j) {
@@ -572,33 +1243,16 @@ static void addItems(QTreeWidget* tw, QStringList& values, bool editable, bool c
 				break;
 		}
 
-		QTreeWidgetItem* item = new QTreeWidgetItem(tw, itemValues);
-		tw->addTopLevelItem(item);
+		QTreeWidgetItem* item = new QTreeWidgetItem(itemValues);
+		items << item;
 
 		Qt::ItemFlags flags = item->flags();
 		if (editable)
 			flags |= Qt::ItemIsEditable;
 		item->setFlags(flags);
 
-		if (selectionType == "checklist") {
-			QCheckBox* cb = new QCheckBox();
-			cb->setContentsMargins(0, 0, 0, 0);
-			if (itemValues.at(0).toLower() == "true")
-				cb->setCheckState(Qt::Checked);
-			else
-				cb->setCheckState(Qt::Unchecked);
-			cb->setStyleSheet("QCheckBox::indicator {subcontrol-position: center center;}");
-			tw->setItemWidget(item, 0, cb);
-		} else if (selectionType == "radiolist") {
-			QRadioButton* rb = new QRadioButton();
-			rb->setContentsMargins(0, 0, 0, 0);
-			if (itemValues.at(0).toLower() == "true")
-				rb->setChecked(true);
-			else
-				rb->setChecked(false);
-			rb->setStyleSheet("QRadioButton::indicator {subcontrol-position: center center;}");
-			tw->setItemWidget(item, 0, rb);
-		}
+		if (!selectionType.isEmpty())
+			item->setCheckState(0, itemValues.at(0).toLower() == "true" ? Qt::Checked : Qt::Unchecked);
 		if (icons)
 			item->setIcon(0, QPixmap(item->text(0)));
 		if (checkable || icons) {
@@ -606,6 +1260,31 @@ static void addItems(QTreeWidget* tw, QStringList& values, bool editable, bool c
 			item->setText(0, QString());
 		}
 	}
+
+	// Inserted at once: a single model update and relayout for the whole batch
+	tw->setUpdatesEnabled(false);
+	tw->addTopLevelItems(items);
+	tw->setUpdatesEnabled(true);
+}
+
+// A radio row added as checked (from the row firstAdded) unchecks the others, as when it is
+// checked by hand. The last one added wins.
+static void uncheckOtherRadioRows(QTreeWidget* tw, int firstAdded) {
+	if (meta(tw).listSelectionType != "radiolist")
+		return;
+	QTreeWidgetItem* checked = NULL;
+	for (int i = tw->topLevelItemCount() - 1; i >= firstAdded && !checked; --i) {
+		if (tw->topLevelItem(i)->checkState(0) == Qt::Checked)
+			checked = tw->topLevelItem(i);
+	}
+	if (!checked)
+		return;
+	const bool blocked = tw->blockSignals(true);
+	for (int i = 0; i < tw->topLevelItemCount(); ++i) {
+		if (tw->topLevelItem(i) != checked)
+			tw->topLevelItem(i)->setCheckState(0, Qt::Unchecked);
+	}
+	tw->blockSignals(blocked);
 }
 
 static void buildFormsList(QTreeWidget** tree, GList& list, QStringList& columns, bool& showHeader,
@@ -626,7 +1305,8 @@ static void buildFormsList(QTreeWidget** tree, GList& list, QStringList& columns
 	}
 
 	list.val = addColumnToListValues(list.val, list.addValue, columnCount);
-	QString selectionType = tw->property("guid_list_selection_type").toString();
+	QString selectionType = meta(tw).listSelectionType;
+	editMeta(tw).listFlags = int(bool(flags & Qt::ItemIsEditable) | !selectionType.isEmpty() << 1);
 
 	for (int i = 0; i < list.val.count();) {
 		QStringList itemValues;
@@ -642,25 +1322,8 @@ static void buildFormsList(QTreeWidget** tree, GList& list, QStringList& columns
 		item->setFlags(flags);
 		item->setTextAlignment(0, Qt::AlignLeft);
 
-		if (selectionType == "checklist") {
-			QCheckBox* cb = new QCheckBox();
-			cb->setContentsMargins(0, 0, 0, 0);
-			if (itemValues.at(0).toLower() == "true")
-				cb->setCheckState(Qt::Checked);
-			else
-				cb->setCheckState(Qt::Unchecked);
-			cb->setStyleSheet("QCheckBox::indicator {subcontrol-position: center center;}");
-			tw->setItemWidget(item, 0, cb);
-		} else if (selectionType == "radiolist") {
-			QRadioButton* rb = new QRadioButton();
-			rb->setContentsMargins(0, 0, 0, 0);
-			if (itemValues.at(0).toLower() == "true")
-				rb->setChecked(true);
-			else
-				rb->setChecked(false);
-			rb->setStyleSheet("QRadioButton::indicator {subcontrol-position: center center;}");
-			tw->setItemWidget(item, 0, rb);
-		}
+		if (!selectionType.isEmpty())
+			item->setCheckState(0, itemValues.at(0).toLower() == "true" ? Qt::Checked : Qt::Unchecked);
 
 		if (!selectionType.isEmpty())
 			item->setText(0, QString());
@@ -669,8 +1332,11 @@ static void buildFormsList(QTreeWidget** tree, GList& list, QStringList& columns
 	for (int i = 0; i < columns.count(); ++i)
 		tw->resizeColumnToContents(i);
 
-	if (!selectionType.isEmpty())
+	tw->setUniformRowHeights(true);
+	if (!selectionType.isEmpty()) {
+		tw->setItemDelegateForColumn(0, new SelectionColumn(selectionType == "radiolist", tw));
 		tw->header()->setSectionResizeMode(0, QHeaderView::Fixed);
+	}
 
 	tw->setStyleSheet(QTREEWIDGET_STYLE);
 
@@ -682,9 +1348,9 @@ static void buildFormsList(QTreeWidget** tree, GList& list, QStringList& columns
 			tw->setFixedHeight(height);
 	}
 
-	int roColumnNumber = tw->property("guid_list_read_only_column").toInt();
+	int roColumnNumber = meta(tw).listReadOnlyColumn;
 	roColumnNumber = roColumnNumber - 1;
-	if (roColumnNumber >= 0 && roColumnNumber < columns.count())
+	if (roColumnNumber >= (selectionType.isEmpty() ? 0 : 1) && roColumnNumber < columns.count())
 		tw->setItemDelegateForColumn(roColumnNumber, new ReadOnlyColumn(tw));
 
 	list = GList();
@@ -695,220 +1361,577 @@ static void buildFormsList(QTreeWidget** tree, GList& list, QStringList& columns
 	*tree = NULL;
 }
 
-static ValuePair getFormsWidgetValue(const QWidget* w, const QString& dateFormat,
-    const QString& separator, const QString& listRowSeparator) {
-	if (!w || w->property("guid_hide").toBool())
-		return ValuePair(false, QString());
+static void formCacheAddFile(const QString& path) {
+	if (!gs_formCache || gs_formCache->loaded)
+		return;
+
+	// Missing files are recorded too, so that creating them invalidates the entry
+	QFileInfo info(path);
+	gs_formCache->files.insert(path, info.exists() ? qMakePair(info.lastModified().toMSecsSinceEpoch(), info.size()) : qMakePair(qint64(-1), qint64(-1)));
+}
+
+static QString formCacheEntryPath(const QString& dir, const QStringList& args) {
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(APP_VERSION);
+	hash.addData(QDir::currentPath().toUtf8()); // relative paths in the arguments
+	foreach (const QString& arg, args) {
+		hash.addData(arg.toUtf8());
+		hash.addData("", 1);
+	}
+
+	return dir + "/" + QString::fromLatin1(hash.result().toHex()) + ".guidform";
+}
+
+static bool loadFormCache(const QString& entryPath, FormCache& cache) {
+	QFile file(entryPath);
+	if (!file.open(QIODevice::ReadOnly) || file.size() == 0)
+		return false;
+	uchar* data = file.map(0, file.size());
+	if (!data)
+		return false;
+
+	QDataStream in(QByteArray::fromRawData(reinterpret_cast<const char*>(data), file.size()));
+	in.setVersion(QDataStream::Qt_5_0);
+	quint32 magic, version;
+	in >> magic >> version;
+	if (magic != 0x47554946 || version != 1) // "GUIF"
+		return false;
+	in >> cache.args >> cache.files >> cache.values;
+	file.unmap(data);
+	if (in.status() != QDataStream::Ok || cache.args.isEmpty())
+		return false;
+
+	for (QHash<QString, QPair<qint64, qint64>>::const_iterator it = cache.files.constBegin(); it != cache.files.constEnd(); ++it) {
+		QFileInfo info(it.key());
+		const qint64 modified = info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+		const qint64 size = info.exists() ? info.size() : -1;
+		if (modified != it.value().first || size != it.value().second)
+			return false;
+	}
+
+	cache.loaded = true;
+	return true;
+}
+
+static void saveFormCache(const QString& entryPath, const FormCache& cache) {
+	QDir().mkpath(QFileInfo(entryPath).path());
+	QSaveFile file(entryPath);
+	if (!file.open(QIODevice::WriteOnly))
+		return;
+
+	QDataStream out(&file);
+	out.setVersion(QDataStream::Qt_5_0);
+	out << quint32(0x47554946) << quint32(1) << cache.args << cache.files << cache.values;
+	if (out.status() == QDataStream::Ok)
+		file.commit();
+}
+
+// Ends the use of gs_formCache, writing the entry if the form was built from disk
+static void finishFormCache(const QString& entryPath, bool save) {
+	if (!gs_formCache)
+		return;
+	if (save && !gs_formCache->loaded)
+		saveFormCache(entryPath, *gs_formCache);
+	delete gs_formCache;
+	gs_formCache = NULL;
+}
+
+// Appends text to the output plan, merged with the literal before it if any
+static void addOutputLiteral(QList<OutputStep>& plan, const QString& text) {
+	if (text.isEmpty())
+		return;
+	if (!plan.isEmpty() && plan.last().kind == OutputStep::Literal) {
+		plan.last().text += text;
+		return;
+	}
+	OutputStep step;
+	step.kind = OutputStep::Literal;
+	step.text = text;
+	plan << step;
+}
+
+static void addOutputStep(QList<OutputStep>& plan, OutputStep::Kind kind, const QWidget* w, int index = -1) {
+	OutputStep step;
+	step.kind = kind;
+	step.widget = w;
+	step.index = index;
+	plan << step;
+}
+
+static void addOutputSteps(QList<OutputStep>& plan, const QList<OutputStep>& steps) {
+	foreach (const OutputStep& step, steps) {
+		if (step.kind == OutputStep::Literal)
+			addOutputLiteral(plan, step.text);
+		else
+			plan << step;
+	}
+}
+
+// Appends to plan the steps printing the value of a form widget, with its variable name.
+// What is printed and in which order is known once the form is built, so the widget
+// tree is walked here only once. Returns false when the widget prints nothing.
+static bool addFormsOutputSteps(const QWidget* w, const QString& separator, QList<OutputStep>& plan) {
+	if (!w || meta(w).hide)
+		return false;
 
-	QString var = w->property("guid_var").toString().simplified().replace(" ", "");
+	QString var = meta(w).var.simplified().replace(" ", "");
 	if (!var.isEmpty())
 		var += "=";
 
+	OutputStep::Kind kind;
 	IF_IS(QLineEdit) {
-		return ValuePair(true, var + t->text());
+		kind = OutputStep::LineEdit;
 	}
 	else IF_IS(QTreeWidget) {
-		if (t->selectionMode() == QAbstractItemView::NoSelection || t->property("guid_list_exclude_from_output").toBool())
-			return ValuePair(false, QString());
-
-		QString results = "";
-		QString rowValue;
-		QString printColumn = t->property("guid_list_print_column").toString();
-		QString printMode = t->property("guid_list_print_values_mode").toString();
-		QString selectionType = t->property("guid_list_selection_type").toString();
-		QList<QTreeWidgetItem*> itemsToCheck;
-
-		if (selectionType == "checklist" || selectionType == "radiolist" || printMode == "all") {
-			for (int i = 0; i < t->topLevelItemCount(); ++i) {
-				QTreeWidgetItem* item = t->topLevelItem(i);
-				itemsToCheck << item;
-			}
-		} else {
-			itemsToCheck = t->selectedItems();
-		}
-
-		if (selectionType == "checklist" || selectionType == "radiolist") {
-			bool isChecked = false;
-			int itemNo = 0;
-			foreach (QTreeWidgetItem* item, itemsToCheck) {
-				if (selectionType == "checklist") {
-					QCheckBox* cb = qobject_cast<QCheckBox*>(t->itemWidget(item, 0));
-					isChecked = cb->isChecked();
-				} else if (selectionType == "radiolist") {
-					QRadioButton* rb = qobject_cast<QRadioButton*>(t->itemWidget(item, 0));
-					isChecked = rb->isChecked();
-				}
-
-				if (isChecked || printMode == "all") {
-					rowValue = "";
-					for (int i = 0; i < t->columnCount(); ++i) {
-						if (printColumn == "all" || printColumn == QString::number(i + 1)) {
-							if (i > 0)
-								rowValue += ',';
-
-							if (i == 0) {
-								if (isChecked)
-									rowValue += "true";
-								else
-									rowValue += "false";
-							} else {
-								rowValue += item->text(i);
-							}
-						}
-					}
-					if (itemNo > 0)
-						results += listRowSeparator;
-					results += rowValue;
-					itemNo++;
-				}
-			}
-		} else {
-			int itemNo = 0;
-			foreach (QTreeWidgetItem* item, itemsToCheck) {
-				rowValue = "";
-				for (int i = 0; i < t->columnCount(); ++i) {
-					if (printColumn == "all" || printColumn == QString::number(i + 1)) {
-						if (i > 0)
-							rowValue += ',';
-						rowValue += item->text(i);
-					}
-				}
-				if (itemNo > 0)
-					results += listRowSeparator;
-				results += rowValue;
-				itemNo++;
-			}
-		}
-		return ValuePair(true, var + results);
+		if (t->selectionMode() == QAbstractItemView::NoSelection || meta(t).listExcludeFromOutput)
+			return false;
+		kind = OutputStep::List;
 	}
 	else IF_IS(QComboBox) {
-		return ValuePair(true, var + t->currentText());
+		kind = OutputStep::Combo;
 	}
 	else IF_IS(QCalendarWidget) {
-		if (dateFormat.isNull())
-			return ValuePair(true, var + QLocale::system().toString(t->selectedDate(), QLocale::ShortFormat));
-		return ValuePair(true, var + t->selectedDate().toString(dateFormat));
+		kind = OutputStep::Calendar;
 	}
 	else IF_IS(QCheckBox) {
-		return ValuePair(true, t->isChecked() ? var + "true" : var + "false");
+		kind = OutputStep::CheckBox;
 	}
 	else IF_IS(QSlider) {
-		return ValuePair(true, var + QString::number(t->value()));
+		kind = OutputStep::Slider;
 	}
 	else IF_IS(QSpinBox) {
-		return ValuePair(true, var + QString::number(t->value()));
+		kind = OutputStep::SpinBox;
 	}
 	else IF_IS(QDoubleSpinBox) {
-		return ValuePair(true, var + QString::number(t->value()));
+		kind = OutputStep::DoubleSpinBox;
 	}
 	else IF_IS(QTabWidget) {
-		QString tabsValue = NULL;
-		ValuePair resultPair;
-		ValuePair tabPair;
-
-		bool verboseMode = t->property("guid_tab_bar_verbose").toBool();
-		QString tabValue = "";
-		QString tabValuePrefix = "";
-		QString tabValueSuffix = "";
-		QString tabSelectionMarker = "";
-		bool addTabValue = false;
-
+		const bool verboseMode = meta(t).tabBarVerbose;
+		bool hasTabValue = false;
 		for (int i = 0; i < t->count(); ++i) {
-			tabValue = "";
-			tabValuePrefix = "";
-			tabValueSuffix = "";
-			tabSelectionMarker = "";
-			addTabValue = false;
-
 			QWidget* tab = t->widget(i);
-
-			if (tab && verboseMode) {
-				if (i == t->currentIndex())
-					tabSelectionMarker = "*";
-				tabValuePrefix = "<TAB_START" + tabSelectionMarker + ">" + t->tabText(i) + "</TAB_START" + tabSelectionMarker + ">";
-				tabValueSuffix = "<TAB_END" + tabSelectionMarker + ">" + t->tabText(i) + "</TAB_END" + tabSelectionMarker + ">";
-			}
-
-			QList<QWidget*> tabChildren = tab->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly);
-			foreach (QWidget* tabChild, tabChildren) {
+			QList<OutputStep> tabPlan;
+			bool hasValue = false;
+			foreach (QWidget* tabChild, tab->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly)) {
 				if (qstrcmp(tabChild->metaObject()->className(), "QLabel") == 0)
 					continue;
-				tabPair = getFormsWidgetValue(tabChild, dateFormat, separator, listRowSeparator);
-				if (tabPair.first) {
-					addTabValue = true;
-					if (!tabValue.isEmpty())
-						tabValue += separator;
-					tabValue += tabPair.second;
-				}
+				QList<OutputStep> childPlan;
+				if (!addFormsOutputSteps(tabChild, separator, childPlan))
+					continue;
+				if (hasValue)
+					addOutputLiteral(tabPlan, separator);
+				addOutputSteps(tabPlan, childPlan);
+				hasValue = true;
 			}
+			if (!hasValue)
+				continue;
 
-			if (addTabValue) {
-				if (!tabsValue.isEmpty())
-					tabsValue += separator;
-				tabsValue += tabValuePrefix + tabValue + tabValueSuffix;
-			}
+			addOutputLiteral(plan, hasTabValue ? separator : var);
+			if (verboseMode)
+				addOutputStep(plan, OutputStep::TabStart, t, i);
+			addOutputSteps(plan, tabPlan);
+			if (verboseMode)
+				addOutputStep(plan, OutputStep::TabEnd, t, i);
+			hasTabValue = true;
 		}
-
-		resultPair = ValuePair(true, tabsValue);
-		if (tabsValue.isNull())
-			resultPair.first = false;
-		else
-			resultPair.second = var + resultPair.second;
-
-		return resultPair;
+		return hasTabValue;
 	}
 	else IF_IS(QTextEdit) {
-		if (!t->isReadOnly()) {
-			ValuePair resultPair = ValuePair(true, var + t->toPlainText());
-			QString nsep = t->property("guid_text_info_nsep").toString();
-			if (!nsep.isEmpty())
-				resultPair.second.replace("\n", nsep);
-			return resultPair;
-		} else {
-			return ValuePair(false, QString());
-		}
+		if (t->isReadOnly())
+			return false;
+		kind = OutputStep::TextEdit;
 	}
 	else IF_IS(QWidget) {
-		QString widgetsValue = NULL;
-		ValuePair resultPair;
-		ValuePair widgetPair;
-		if (t->property("guid_list_container").toBool() || t->property("guid_cols_container").toBool() || t->property("guid_file_sel_container").toBool() || t->property("guid_scale_container").toBool() || qstrcmp(t->metaObject()->className(), "QGroupBox") == 0) {
-			int nbResults = 0;
-			QList<QWidget*> wChildren = t->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly);
-			foreach (QWidget* widget, wChildren) {
-				if (qstrcmp(widget->metaObject()->className(), "QLabel") == 0)
-					continue;
-				widgetPair = getFormsWidgetValue(widget, dateFormat, separator, listRowSeparator);
-				if (widgetPair.first) {
-					if (nbResults > 0) {
-						widgetsValue += separator;
-					}
-					widgetsValue += widgetPair.second;
-					nbResults++;
-				}
-			}
+		if (meta(t).container == WidgetMeta::NoContainer && qstrcmp(t->metaObject()->className(), "QGroupBox") != 0)
+			return false;
+		bool hasValue = false;
+		foreach (QWidget* widget, t->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly)) {
+			if (qstrcmp(widget->metaObject()->className(), "QLabel") == 0)
+				continue;
+			QList<OutputStep> childPlan;
+			if (!addFormsOutputSteps(widget, separator, childPlan))
+				continue;
+			addOutputLiteral(plan, hasValue ? separator : var);
+			addOutputSteps(plan, childPlan);
+			hasValue = true;
 		}
-		resultPair = ValuePair(true, widgetsValue);
-		if (widgetsValue.isNull())
-			resultPair.first = false;
-		else
-			resultPair.second = var + resultPair.second;
-		return resultPair;
+		return hasValue;
+	}
+	else {
+		return false;
 	}
-	return ValuePair(false, QString());
-}
 
-static bool getWidgetSettingBool(QString setting) {
-	QString value = setting.toLower().section('=', 1, 1);
-	return (value == "1" || value == "true") ? true : false;
+	addOutputLiteral(plan, var);
+	addOutputStep(plan, kind, w);
+	return true;
 }
 
-static int getWidgetSettingInt(QString setting) {
-	bool ok;
-	int value = setting.section('=', 1, 1).toInt(&ok);
-	if (!ok)
-		value = -100;
-	return value;
+// Appends to plan the keyed steps of a form widget for the json, nul and shell output
+// formats. The key is the variable name, the one of the container (passed as key) or
+// "fieldN", N counting the keys given that way. Returns false when the widget prints nothing.
+static bool addFormsFieldSteps(const QWidget* w, QString key, QList<OutputStep>& plan, int& fieldNo) {
+	if (!w || meta(w).hide)
+		return false;
+
+	const QString var = meta(w).var.simplified().replace(" ", "");
+	if (!var.isEmpty())
+		key = var;
+
+	OutputStep::Kind kind;
+	IF_IS(QLineEdit) {
+		kind = OutputStep::LineEdit;
+	}
+	else IF_IS(QTreeWidget) {
+		if (t->selectionMode() == QAbstractItemView::NoSelection || meta(t).listExcludeFromOutput)
+			return false;
+		kind = OutputStep::List;
+	}
+	else IF_IS(QComboBox) {
+		kind = OutputStep::Combo;
+	}
+	else IF_IS(QCalendarWidget) {
+		kind = OutputStep::Calendar;
+	}
+	else IF_IS(QCheckBox) {
+		kind = OutputStep::CheckBox;
+	}
+	else IF_IS(QSlider) {
+		kind = OutputStep::Slider;
+	}
+	else IF_IS(QSpinBox) {
+		kind = OutputStep::SpinBox;
+	}
+	else IF_IS(QDoubleSpinBox) {
+		kind = OutputStep::DoubleSpinBox;
+	}
+	else IF_IS(QTabWidget) {
+		// {"key": {"tab text": {fields}, ...}}
+		const int keyNo = key.isEmpty() ? ++fieldNo : 0;
+		QList<OutputStep> tabsPlan;
+		for (int i = 0; i < t->count(); ++i) {
+			QList<OutputStep> tabPlan;
+			foreach (QWidget* tabChild, t->widget(i)->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly)) {
+				if (qstrcmp(tabChild->metaObject()->className(), "QLabel") != 0)
+					addFormsFieldSteps(tabChild, QString(), tabPlan, fieldNo);
+			}
+			if (tabPlan.isEmpty())
+				continue;
+			addOutputStep(tabsPlan, OutputStep::ObjectStart, t, i);
+			tabsPlan.last().text = t->tabText(i);
+			tabsPlan << tabPlan;
+			addOutputStep(tabsPlan, OutputStep::ObjectEnd, t, i);
+		}
+		if (tabsPlan.isEmpty()) {
+			if (keyNo)
+				fieldNo = keyNo - 1;
+			return false;
+		}
+		addOutputStep(plan, OutputStep::ObjectStart, t);
+		plan.last().text = keyNo ? "field" + QString::number(keyNo) : key;
+		plan << tabsPlan;
+		addOutputStep(plan, OutputStep::ObjectEnd, t);
+		return true;
+	}
+	else IF_IS(QTextEdit) {
+		if (t->isReadOnly())
+			return false;
+		kind = OutputStep::TextEdit;
+	}
+	else IF_IS(QGroupBox) {
+		// {"key or title": {fields}}
+		if (key.isEmpty())
+			key = t->title();
+		const int keyNo = key.isEmpty() ? ++fieldNo : 0;
+		QList<OutputStep> groupPlan;
+		foreach (QWidget* widget, t->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly)) {
+			if (qstrcmp(widget->metaObject()->className(), "QLabel") != 0)
+				addFormsFieldSteps(widget, QString(), groupPlan, fieldNo);
+		}
+		if (groupPlan.isEmpty()) {
+			if (keyNo)
+				fieldNo = keyNo - 1;
+			return false;
+		}
+		addOutputStep(plan, OutputStep::ObjectStart, t);
+		plan.last().text = keyNo ? "field" + QString::number(keyNo) : key;
+		plan << groupPlan;
+		addOutputStep(plan, OutputStep::ObjectEnd, t);
+		return true;
+	}
+	else IF_IS(QWidget) {
+		// Containers are not objects: their key goes to their first field
+		if (meta(t).container == WidgetMeta::NoContainer)
+			return false;
+		bool hasValue = false;
+		foreach (QWidget* widget, t->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly)) {
+			if (qstrcmp(widget->metaObject()->className(), "QLabel") == 0)
+				continue;
+			if (addFormsFieldSteps(widget, hasValue ? QString() : key, plan, fieldNo))
+				hasValue = true;
+		}
+		return hasValue;
+	}
+	else {
+		return false;
+	}
+
+	addOutputStep(plan, kind, w);
+	plan.last().text = key.isEmpty() ? "field" + QString::number(++fieldNo) : key;
+	return true;
+}
+
+static bool outputFormatFromName(const QString& name, OutputFormat& format) {
+	if (name == "text")
+		format = OutputFormat::Text;
+	else if (name == "json")
+		format = OutputFormat::Json;
+	else if (name == "nul")
+		format = OutputFormat::Nul;
+	else if (name == "shell")
+		format = OutputFormat::Shell;
+	else
+		return false;
+	return true;
+}
+
+// Appends text as a value of the output format: a JSON string, or the content of a
+// single-quoted shell word
+static void appendOutputText(QString& out, const QString& text, OutputFormat format) {
+	if (format == OutputFormat::Json) {
+		out += '"';
+		foreach (const QChar c, text) {
+			const ushort u = c.unicode();
+			if (u == '"' || u == '\\') {
+				out += '\\';
+				out += c;
+			} else if (u == '\n') {
+				out += QLatin1String("\\n");
+			} else if (u == '\r') {
+				out += QLatin1String("\\r");
+			} else if (u == '\t') {
+				out += QLatin1String("\\t");
+			} else if (u < 0x20) {
+				out += QString("\\u%1").arg(u, 4, 16, QChar('0'));
+			} else {
+				out += c;
+			}
+		}
+		out += '"';
+	} else if (format == OutputFormat::Shell && text.contains('\'')) {
+		foreach (const QChar c, text) {
+			if (c == '\'')
+				out += QLatin1String("'\\''");
+			else
+				out += c;
+		}
+	} else {
+		out += text;
+	}
+}
+
+// Appends the rows of a list printed by --list or a form: in text, rows joined by
+// rowSeparator and columns by ","; in json, an array of rows, each an array of columns;
+// in nul and shell, rows joined by rowSeparator and columns by a tab. Returns the number
+// of rows.
+static int appendListRows(QString& out, const QTreeWidget* t, OutputFormat format, const QString& rowSeparator) {
+	const QString printColumn = meta(t).listPrintColumn;
+	const QString printMode = meta(t).listPrintValuesMode;
+	const QString selectionType = meta(t).listSelectionType;
+	const bool hasSelection = selectionType == "checklist" || selectionType == "radiolist";
+	const bool printAll = printMode == "all";
+	const bool json = format == OutputFormat::Json;
+	const QChar columnSeparator = format == OutputFormat::Text || json ? ',' : '\t';
+
+	QList<QTreeWidgetItem*> itemsToCheck;
+	if (hasSelection || printAll) {
+		for (int i = 0; i < t->topLevelItemCount(); ++i)
+			itemsToCheck << t->topLevelItem(i);
+	} else {
+		itemsToCheck = t->selectedItems();
+	}
+
+	if (json)
+		out += '[';
+	int itemNo = 0;
+	foreach (QTreeWidgetItem* item, itemsToCheck) {
+		const bool isChecked = hasSelection && item->checkState(0) == Qt::Checked;
+		if (hasSelection && !isChecked && !printAll)
+			continue;
+		if (itemNo > 0) {
+			if (json)
+				out += ',';
+			else
+				out += rowSeparator;
+		}
+		if (json)
+			out += '[';
+		int columnNo = 0;
+		for (int i = 0; i < t->columnCount(); ++i) {
+			if (printColumn == "all" || printColumn == QString::number(i + 1)) {
+				// Text output keeps its leading "," when only a later column is printed
+				if (format == OutputFormat::Text ? i > 0 : columnNo > 0)
+					out += columnSeparator;
+				if (i == 0 && hasSelection)
+					out += isChecked ? QLatin1String("true") : QLatin1String("false");
+				else
+					appendOutputText(out, item->text(i), format);
+				columnNo++;
+			}
+		}
+		if (json)
+			out += ']';
+		itemNo++;
+	}
+	if (json)
+		out += ']';
+	return itemNo;
+}
+
+// Appends the value of a field of the output plan as it is when the form is printed.
+// Numbers and booleans are bare in every format.
+static void appendFormsValue(QString& out, const OutputStep& step, OutputFormat format, const QString& dateFormat, const QString& listRowSeparator) {
+	switch (step.kind) {
+	case OutputStep::Literal:
+		out += step.text;
+		break;
+	case OutputStep::Calendar: {
+		const QDate date = static_cast<const QCalendarWidget*>(step.widget)->selectedDate();
+		appendOutputText(out, dateFormat.isNull() ? QLocale::system().toString(date, QLocale::ShortFormat) : date.toString(dateFormat), format);
+		break;
+	}
+	case OutputStep::CheckBox:
+		out += static_cast<const QCheckBox*>(step.widget)->isChecked() ? QLatin1String("true") : QLatin1String("false");
+		break;
+	case OutputStep::Combo:
+		appendOutputText(out, static_cast<const QComboBox*>(step.widget)->currentText(), format);
+		break;
+	case OutputStep::DoubleSpinBox:
+		out += QString::number(static_cast<const QDoubleSpinBox*>(step.widget)->value());
+		break;
+	case OutputStep::LineEdit:
+		appendOutputText(out, static_cast<const QLineEdit*>(step.widget)->text(), format);
+		break;
+	case OutputStep::List:
+		appendListRows(out, static_cast<const QTreeWidget*>(step.widget), format, listRowSeparator);
+		break;
+	case OutputStep::ObjectEnd:
+	case OutputStep::ObjectStart:
+		break;
+	case OutputStep::Slider:
+		out += QString::number(static_cast<const QSlider*>(step.widget)->value());
+		break;
+	case OutputStep::SpinBox:
+		out += QString::number(static_cast<const QSpinBox*>(step.widget)->value());
+		break;
+	case OutputStep::TabEnd:
+	case OutputStep::TabStart: {
+		const QTabWidget* t = static_cast<const QTabWidget*>(step.widget);
+		const QString tabSelectionMarker = step.index == t->currentIndex() ? "*" : "";
+		const QString tag = step.kind == OutputStep::TabStart ? "TAB_START" : "TAB_END";
+		out += "<" + tag + tabSelectionMarker + ">" + t->tabText(step.index) + "</" + tag + tabSelectionMarker + ">";
+		break;
+	}
+	case OutputStep::TextEdit: {
+		const QTextEdit* t = static_cast<const QTextEdit*>(step.widget);
+		QString text = t->toPlainText();
+		const QString nsep = meta(t).textInfoNsep;
+		if (!nsep.isEmpty() && format == OutputFormat::Text)
+			text.replace("\n", nsep);
+		appendOutputText(out, text, format);
+		break;
+	}
+	}
+}
+
+// Appends a keyed field on its own: a line of the shell output, a record of the nul
+// output, a one-key object line for json, or a key=value line for text
+static void appendKeyedField(QString& out, const OutputStep& step, OutputFormat format, const QString& dateFormat, const QString& listRowSeparator) {
+	switch (format) {
+	case OutputFormat::Json:
+		out += '{';
+		appendOutputText(out, step.text, format);
+		out += ':';
+		appendFormsValue(out, step, format, dateFormat, listRowSeparator);
+		out += QLatin1String("}\n");
+		break;
+	case OutputFormat::Shell:
+		// Variable names are limited to letters, digits and "_"
+		if (step.text.at(0).isDigit())
+			out += '_';
+		foreach (const QChar c, step.text)
+			out += c.isLetterOrNumber() && c.unicode() < 128 ? c : QChar('_');
+		out += QLatin1String("='");
+		appendFormsValue(out, step, format, dateFormat, listRowSeparator);
+		out += QLatin1String("'\n");
+		break;
+	case OutputFormat::Nul:
+	case OutputFormat::Text:
+		out += step.text;
+		out += '=';
+		appendFormsValue(out, step, format, dateFormat, listRowSeparator);
+		out += format == OutputFormat::Nul ? QChar(0) : QChar('\n');
+		break;
+	}
+}
+
+// The text of a scalar from a --control command
+static QString controlText(const QJsonValue& value) {
+	if (value.isBool())
+		return value.toBool() ? "true" : "false";
+	if (value.isDouble())
+		return QString::number(value.toDouble());
+	return value.toString();
+}
+
+// Gives a form field the value of a --control "set" command. Returns false when the
+// field has no value that can be set this way.
+static bool setFormsWidgetValue(QWidget* w, const QJsonValue& value, const QString& dateFormat) {
+	const QString text = controlText(value);
+	if (QLineEdit* t = qobject_cast<QLineEdit*>(w)) {
+		t->setText(text);
+	} else if (QComboBox* t = qobject_cast<QComboBox*>(w)) {
+		const int index = t->findText(text);
+		if (index > -1)
+			t->setCurrentIndex(index);
+		else if (t->isEditable())
+			t->setEditText(text);
+		else
+			return false;
+	} else if (QCalendarWidget* t = qobject_cast<QCalendarWidget*>(w)) {
+		const QDate date = dateFormat.isEmpty() ? QDate::fromString(text, Qt::ISODate) : QDate::fromString(text, dateFormat);
+		if (!date.isValid())
+			return false;
+		t->setSelectedDate(date);
+	} else if (QCheckBox* t = qobject_cast<QCheckBox*>(w)) {
+		t->setChecked(text == "true" || text == "1");
+	} else if (QSlider* t = qobject_cast<QSlider*>(w)) {
+		t->setValue(qRound(text.toDouble()));
+	} else if (QSpinBox* t = qobject_cast<QSpinBox*>(w)) {
+		t->setValue(qRound(text.toDouble()));
+	} else if (QDoubleSpinBox* t = qobject_cast<QDoubleSpinBox*>(w)) {
+		t->setValue(text.toDouble());
+	} else if (QTextEdit* t = qobject_cast<QTextEdit*>(w)) {
+		if (meta(t).textFormat == "html")
+			t->setHtml(text);
+		else
+			t->setPlainText(text);
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static bool getWidgetSettingBool(QString setting) {
+	QString value = setting.toLower().section('=', 1, 1);
+	return (value == "1" || value == "true") ? true : false;
+}
+
+static int getWidgetSettingInt(QString setting) {
+	bool ok;
+	int value = setting.section('=', 1, 1).toInt(&ok);
+	if (!ok)
+		value = -100;
+	return value;
 }
 
 static QString getWidgetSettingQString(QString setting) {
@@ -917,6 +1940,158 @@ static QString getWidgetSettingQString(QString setting) {
 	return results.join("=");
 }
 
+// True if no byte of data has its high bit set, that is, if data can be decoded as Latin-1
+static bool isAscii(const char* data, qint64 size) {
+	const char* p = data;
+	const char* end = data + size;
+#ifdef __SSE2__
+	__m128i high = _mm_setzero_si128();
+	for (; end - p >= 16; p += 16)
+		high = _mm_or_si128(high, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+	if (_mm_movemask_epi8(high))
+		return false;
+#endif
+	for (; p < end; ++p) {
+		if (*p & 0x80)
+			return false;
+	}
+
+	return true;
+}
+
+// Returns the first line break or sepByte in [p, end), or end
+static const char* findValueBreak(const char* p, const char* end, char sepByte) {
+#ifdef __SSE2__
+	const __m128i lf = _mm_set1_epi8('\n');
+	const __m128i cr = _mm_set1_epi8('\r');
+	const __m128i sb = _mm_set1_epi8(sepByte);
+	for (; end - p >= 16; p += 16) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		__m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr)),
+		    _mm_cmpeq_epi8(chunk, sb));
+		int mask = _mm_movemask_epi8(hits);
+		if (mask)
+			return p + qCountTrailingZeroBits(quint32(mask));
+	}
+#endif
+	for (; p < end; ++p) {
+		if (*p == '\n' || *p == '\r' || *p == sepByte)
+			return p;
+	}
+
+	return end;
+}
+
+// Splits UTF-8 data at each separator and each run of line breaks, as replacing the
+// runs by the separator and then splitting would. A separator made only of line breaks
+// is a line break run. With trim, leading and trailing whitespace is ignored.
+static QStringList splitValues(const char* data, qint64 size, const QByteArray& sep, bool trim = true) {
+	QStringList values;
+	const char* begin = data;
+	const char* end = data + size;
+	if (trim) {
+		while (begin < end && isspace(uchar(*begin)))
+			++begin;
+		while (end > begin && isspace(uchar(*(end - 1))))
+			--end;
+	}
+
+	bool lineSep = true;
+	foreach (char c, sep) {
+		if (c != '\n' && c != '\r')
+			lineSep = false;
+	}
+	const char sepByte = lineSep ? '\n' : sep.at(0);
+	const int sepLength = sep.length();
+
+	// Pure ASCII, the most common case, is decoded without the UTF-8 decoder
+	const bool ascii = isAscii(begin, end - begin);
+	auto decode = [ascii](const char* from, const char* to) {
+		return ascii ? QString::fromLatin1(from, int(to - from)) : QString::fromUtf8(from, int(to - from));
+	};
+
+	const char* value = begin;
+	for (const char* p = findValueBreak(begin, end, sepByte); p < end; p = findValueBreak(p, end, sepByte)) {
+		if (*p == '\n' || *p == '\r') {
+			values << decode(value, p);
+			while (p < end && (*p == '\n' || *p == '\r'))
+				++p;
+			value = p;
+		} else if (end - p >= sepLength && memcmp(p, sep.constData(), sepLength) == 0) {
+			values << decode(value, p);
+			p += sepLength;
+			value = p;
+		} else {
+			++p;
+		}
+	}
+	values << decode(value, end);
+
+	return values;
+}
+
+// Reads the values of a file split at fileSep. Safe to call from a FileParser thread.
+// With mapFile, the file is mapped instead of copied: only for a file not monitored, as
+// a mapped file truncated by its writer makes the process crash (SIGBUS).
+// With signature, the one of the values last read: the file is not read when its size and
+// modification time are the same, and not split when its content hash is the same (a
+// touch). signature then describes the file, and changed tells whether values were read.
+static QStringList readValuesFile(const QString& filePath, const QString& fileSep, bool mapFile, FileSignature* signature, bool* changed) {
+	QStringList values;
+	if (changed)
+		*changed = true;
+	QFile file(filePath);
+	if (!file.open(QIODevice::ReadOnly)) {
+		if (signature)
+			*signature = FileSignature();
+		return values;
+	}
+
+	QByteArray sep = fileSep.toUtf8();
+	QByteArray sepLineBreaks = sep;
+	sepLineBreaks.replace('\r', "").replace('\n', "");
+	const qint64 size = file.size();
+	const qint64 modified = signature ? QFileInfo(file).lastModified().toMSecsSinceEpoch() : -1;
+	if (signature && !signature->hash.isNull() && signature->size == size && signature->modified == modified) {
+		if (changed)
+			*changed = false;
+		return values;
+	}
+
+	// A mapped file is split where it lies, without intermediate copies
+	QByteArray content;
+	uchar* data = mapFile && size > 0 ? file.map(0, size) : NULL;
+	if (!data)
+		content = file.readAll();
+	const char* begin = data ? reinterpret_cast<const char*>(data) : content.constData();
+	const qint64 length = data ? size : content.size();
+
+	if (signature) {
+		const QByteArray hash = QCryptographicHash::hash(QByteArray::fromRawData(begin, int(length)), QCryptographicHash::Md5);
+		const bool touched = hash == signature->hash;
+		signature->hash = hash;
+		signature->modified = modified;
+		signature->size = size;
+		if (touched) {
+			if (changed)
+				*changed = false;
+			if (data)
+				file.unmap(data);
+			return values;
+		}
+	}
+
+	if (sepLineBreaks.isEmpty() || sepLineBreaks.length() == sep.length())
+		values = splitValues(begin, length, sep);
+	else
+		values = QString::fromUtf8(begin, int(length)).trimmed().replace(QRegExp("[\r\n]+"), fileSep).split(fileSep);
+
+	if (data)
+		file.unmap(data);
+
+	return values;
+}
+
 static GList listValuesFromFile(QString data) {
 	GList list = GList();
 	QStringList data_join;
@@ -926,6 +2101,8 @@ static GList listValuesFromFile(QString data) {
 			list.addValue = getWidgetSettingQString(setting);
 		else if (setting.startsWith("monitor="))
 			list.monitorFile = getWidgetSettingBool(setting);
+		else if (setting.startsWith("poll="))
+			list.pollInterval = getWidgetSettingInt(setting);
 		else if (setting.startsWith("sep=")) {
 			list.fileSep = getWidgetSettingQString(setting);
 		} else
@@ -933,33 +2110,399 @@ static GList listValuesFromFile(QString data) {
 	}
 	if (list.fileSep.isEmpty())
 		list.fileSep = "\n";
+	if (list.pollInterval > 0)
+		list.monitorFile = true;
 	list.filePath = data_join.join('@');
-	QFile file(list.filePath);
-	QTextCodec::setCodecForLocale(QTextCodec::codecForName("UTF-8"));
-	if (file.open(QIODevice::ReadOnly)) {
-		list.val = QString::fromLocal8Bit(file.readAll()).trimmed().replace(QRegExp("[\r\n]+"), list.fileSep).split(list.fileSep);
-		file.close();
+
+	const QString cacheKey = list.filePath + '\n' + list.fileSep;
+	if (gs_formCache && gs_formCache->values.contains(cacheKey)) {
+		list.val = gs_formCache->values.value(cacheKey);
+		return list;
 	}
+	formCacheAddFile(list.filePath); // before reading, so a concurrent change is not missed
+
+	list.val = readValuesFile(list.filePath, list.fileSep, !list.monitorFile);
+	if (gs_formCache && !gs_formCache->loaded)
+		gs_formCache->values.insert(cacheKey, list.val);
 	return list;
 }
 
-static bool pathTester(QString filePath) {
-	bool fileExists = false;
-	int timer = 500;
+static Option optionFromArg(const QString& arg) {
+	static QHash<QString, Option> options;
+	if (options.isEmpty()) {
+#define OPTION_ENTRY(id, name) options.insert(QStringLiteral(name), Option::id);
+		GUID_OPTIONS(OPTION_ENTRY)
+#undef OPTION_ENTRY
+	}
 
-	while (timer > 0) {
-		if (QFile::exists(filePath)) {
-			fileExists = true;
+	if (!arg.startsWith(QLatin1String("--")))
+		return Option::Unknown; // values are never options
 
-			break;
+	return options.value(arg, Option::Unknown);
+}
+
+// Returns the options of GUID_OPTIONS missing from the help data
+static QStringList optionsWithoutHelp() {
+	QSet<QString> documented;
+	const HelpDict helpDict = createHelpDict();
+	foreach (const CategoryHelp& category, helpDict) {
+		foreach (const Help& help, category.second) {
+			foreach (const QString& name, help.first.split(", "))
+				documented << name.section(QRegularExpression("[=\\[ \"\n]"), 0, 0);
+		}
+	}
+
+	QStringList missing;
+#define OPTION_CHECK(id, name)                      \
+	if (!documented.contains(QStringLiteral(name))) \
+		missing << QStringLiteral(name);
+	GUID_OPTIONS(OPTION_CHECK)
+#undef OPTION_CHECK
+
+	return missing;
+}
+
+// Reads the widget settings out of an --add-* argument; the remaining tokens are
+// left in arg (joined by "@") as the widget label or value
+static WidgetSettings parseWidgetSettings(QString& arg) {
+	static QHash<QString, WidgetSetting> settingKeys;
+	if (settingKeys.isEmpty()) {
+#define WIDGET_SETTING_ENTRY(id, key) settingKeys.insert(QStringLiteral(key), WidgetSetting::id);
+		WIDGET_SETTINGS(WIDGET_SETTING_ENTRY)
+#undef WIDGET_SETTING_ENTRY
+	}
+
+	WidgetSettings ws;
+	QStringList kept;
+	const int length = arg.length();
+	int start = 0;
+
+	forever {
+		int end = arg.indexOf('@', start);
+		if (end < 0)
+			end = length;
+		const QString setting = arg.mid(start, end - start);
+		const int equal = setting.indexOf('=');
+
+		bool known = equal > 0;
+		if (known) {
+			const QString key = setting.left(equal);
+			WidgetSetting id = settingKeys.value(key, WidgetSetting::Unknown);
+
+			// Marker keys end with the marker number (no leading zero)
+			int marker = 0;
+			if (id == WidgetSetting::Unknown) {
+				int digits = key.length();
+				while (digits > 0 && key.at(digits - 1) >= '0' && key.at(digits - 1) <= '9')
+					--digits;
+				if (digits > 0 && digits < key.length() && key.at(digits) != '0') {
+					marker = key.midRef(digits).toInt();
+					id = settingKeys.value(key.left(digits), WidgetSetting::Unknown);
+				}
+			}
+			const bool isMarkerKey = id == WidgetSetting::DefMarkerVal || id == WidgetSetting::MonitorMarkerFile || id == WidgetSetting::MonitorVarName;
+			if (isMarkerKey != (marker > 0))
+				id = WidgetSetting::Unknown;
+
+			switch (id) {
+			case WidgetSetting::AddLabel:
+				ws.addLabel = getWidgetSettingQString(setting);
+				break;
+			case WidgetSetting::AddNewRowButton:
+				ws.addNewRowButton = getWidgetSettingBool(setting);
+				break;
+			case WidgetSetting::BackgroundColor:
+				ws.backgroundColor = getWidgetSettingQString(setting);
+				break;
+			case WidgetSetting::ButtonText:
+				ws.buttonText = getWidgetSettingQString(setting);
+				break;
+			case WidgetSetting::Command:
+				ws.command = getWidgetSettingQString(setting);
+				break;
+			case WidgetSetting::CommandToFooter:
+				ws.commandToFooter = getWidgetSettingBool(setting);
+				break;
+			case WidgetSetting::DefaultIndex:
+				ws.defaultIndex = getWidgetSettingInt(setting);
+				break;
+			case WidgetSetting::DisableButtons:
+				ws.disableButtons = getWidgetSettingBool(setting);
+				break;
+			case WidgetSetting::ExcludeFromOutput:
+				ws.excludeFromOutput = getWidgetSettingBool(setting);
+				break;
+			case WidgetSetting::ForegroundColor:
+				ws.foregroundColor = getWidgetSettingQString(setting);
+				break;
+			case WidgetSetting::HideLabel:
+				ws.hideLabel = getWidgetSettingBool(setting);
+				break;
+			case WidgetSetting::Image:
+				ws.image = getWidgetSettingQString(setting);
+				break;
+			case WidgetSetting::KeepOpen:
+				ws.keepOpen = getWidgetSettingBool(setting);
+				break;
+			case WidgetSetting::Follow:
+				ws.follow = getWidgetSettingBool(setting);
+				break;
+			case WidgetSetting::Monitor:
+				ws.monitorFile = getWidgetSettingBool(setting);
+				break;
+			case WidgetSetting::Poll:
+				ws.poll = getWidgetSettingInt(setting);
+				break;
+			case WidgetSetting::Selected:
+				ws.selected = getWidgetSettingBool(setting);
+				break;
+			case WidgetSetting::Sep:
+				ws.sep = getWidgetSettingQString(setting);
+				break;
+			case WidgetSetting::Size:
+				ws.size = getWidgetSettingInt(setting);
+				break;
+			case WidgetSetting::Stop:
+				ws.stop = getWidgetSettingBool(setting);
+				break;
+			case WidgetSetting::ValuesToFooter:
+				ws.valuesToFooter = getWidgetSettingBool(setting);
+				break;
+			case WidgetSetting::VerboseTabBar:
+				ws.verboseTabBar = getWidgetSettingBool(setting);
+				break;
+			case WidgetSetting::DefMarkerVal:
+				ws.markers[marker].defVal = getWidgetSettingQString(setting);
+				break;
+			case WidgetSetting::MonitorMarkerFile:
+				ws.markers[marker].file = getWidgetSettingQString(setting);
+				break;
+			case WidgetSetting::MonitorVarName:
+				ws.markers[marker].varName = getWidgetSettingQString(setting);
+				break;
+			default:
+				known = false;
+			}
 		}
 
-		timer = timer - 20;
-		QThread::msleep(20);
+		if (!known)
+			kept << setting;
+		if (end == length)
+			break;
+		start = end + 1;
+	}
+
+	arg = kept.join('@');
+	return ws;
+}
+
+static bool readFormsSpec(const QString& path, QStringList& args, QString& errorMessage) {
+	if (path != "-")
+		formCacheAddFile(path);
+
+	QFile file(path);
+	const bool opened = path == "-" ? file.open(stdin, QIODevice::ReadOnly) : file.open(QIODevice::ReadOnly);
+	if (!opened) {
+		errorMessage = "cannot read " + path;
+		return false;
+	}
+
+	FormsSpecReader reader(&file);
+	if (!reader.read(args)) {
+		errorMessage = path + ", " + reader.errorString();
+		return false;
+	}
+
+	return true;
+}
+
+#ifdef Q_OS_UNIX
+// Tells whether the other end of a connected socket runs as the same user. The socket may
+// be in a world-writable directory, where another user could plant a server or connect.
+static bool peerIsSameUser(int fd) {
+#if defined(SO_PEERCRED)
+	struct ucred credentials;
+	socklen_t length = sizeof(credentials);
+	if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) < 0)
+		return false;
+	return credentials.uid == getuid();
+#else
+	uid_t uid;
+	gid_t gid;
+	if (getpeereid(fd, &uid, &gid) < 0)
+		return false;
+	return uid == getuid();
+#endif
+}
+
+static bool readClientRequest(int fd, int* stdFds, QString& cwd, QStringList& argList) {
+	// A client that stalls must not block the server forever
+	struct timeval timeout = { 5, 0 };
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+	char header[8];
+	union {
+		char buffer[CMSG_SPACE(3 * sizeof(int))];
+		struct cmsghdr align;
+	} control;
+	struct iovec iov = { header, sizeof(header) };
+	struct msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buffer;
+	msg.msg_controllen = sizeof(control.buffer);
+	const ssize_t headerSize = ::recvmsg(fd, &msg, 0);
+
+	int fdCount = 0;
+	struct cmsghdr* cmsg = headerSize > 0 ? CMSG_FIRSTHDR(&msg) : NULL;
+	if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+		fdCount = qMin<int>((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int), 3);
+		memcpy(stdFds, CMSG_DATA(cmsg), fdCount * sizeof(int));
+	}
+
+	bool ok = headerSize == sizeof(header) && fdCount == 3 && !memcmp(header, "GUID", 4);
+	const quint32 size = ok ? qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(header + 4)) : 0;
+	ok = ok && size <= 16 * 1024 * 1024;
+
+	QByteArray payload(ok ? int(size) : 0, Qt::Uninitialized);
+	for (int done = 0; ok && done < payload.size();) {
+		const ssize_t n = ::read(fd, payload.data() + done, payload.size() - done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		ok = n > 0;
+		done += n;
+	}
+
+	// Payload: "cwd\0argv0\0arg1\0...argN\0"
+	QList<QByteArray> fields = payload.split('\0');
+	ok = ok && payload.endsWith('\0') && fields.count() > 2;
+	if (!ok) {
+		for (int i = 0; i < fdCount; ++i)
+			::close(stdFds[i]);
+		return false;
+	}
+
+	fields.removeLast();
+	cwd = QFile::decodeName(fields.takeFirst());
+	argList.clear();
+	foreach (const QByteArray& field, fields)
+		argList << QString::fromLocal8Bit(field);
+
+	return true;
+}
+
+static QByteArray serverSocketPath(QString path) {
+	if (path.isEmpty())
+		path = QString::fromLocal8Bit(qgetenv("GUID_SERVER_SOCKET"));
+	if (path.isEmpty()) {
+		QString dir = QString::fromLocal8Bit(qgetenv("XDG_RUNTIME_DIR"));
+		if (dir.isEmpty())
+			dir = QDir::tempPath();
+		path = QString("%1/guid-server-%2.sock").arg(dir).arg(getuid());
+	}
+
+	return QFile::encodeName(path);
+}
+
+static bool setSocketAddress(struct sockaddr_un* addr, const QByteArray& path) {
+	memset(addr, 0, sizeof(*addr));
+	addr->sun_family = AF_UNIX;
+	if (path.isEmpty() || path.size() >= int(sizeof(addr->sun_path)))
+		return false;
+	memcpy(addr->sun_path, path.constData(), path.size());
+
+	return true;
+}
+
+static int connectToServer(const QByteArray& path) {
+	struct sockaddr_un addr;
+	if (!setSocketAddress(&addr, path))
+		return -1;
+
+	int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0)
+		return -1;
+	if (::connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 || !peerIsSameUser(fd)) {
+		::close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+// Returns the exit code of the dialog shown by the server, or -1 if no server could be reached
+static int runClient(int argc, char** argv) {
+	int fd = connectToServer(serverSocketPath(QString::fromLocal8Bit(argv[1]).section('=', 1)));
+	if (fd < 0)
+		return -1;
+
+	QByteArray payload = QFile::encodeName(QDir::currentPath());
+	payload += '\0';
+	payload += argv[0];
+	payload += '\0';
+	for (int i = 2; i < argc; ++i) {
+		payload += argv[i];
+		payload += '\0';
+	}
+
+	// The header carries our standard streams so the server can use them directly
+	char header[8];
+	memcpy(header, "GUID", 4);
+	qToBigEndian<quint32>(payload.size(), reinterpret_cast<uchar*>(header + 4));
+
+	const int stdFds[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+	union {
+		char buffer[CMSG_SPACE(sizeof(stdFds))];
+		struct cmsghdr align;
+	} control;
+	memset(&control, 0, sizeof(control));
+	struct iovec iov = { header, sizeof(header) };
+	struct msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buffer;
+	msg.msg_controllen = sizeof(control.buffer);
+	struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(stdFds));
+	memcpy(CMSG_DATA(cmsg), stdFds, sizeof(stdFds));
+
+	signal(SIGPIPE, SIG_IGN);
+	bool sent = ::sendmsg(fd, &msg, 0) == sizeof(header);
+	for (int done = 0; sent && done < payload.size();) {
+		const ssize_t n = ::write(fd, payload.constData() + done, payload.size() - done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		sent = n > 0;
+		done += n;
+	}
+	signal(SIGPIPE, SIG_DFL);
+
+	uchar reply[4];
+	size_t received = 0;
+	while (sent && received < sizeof(reply)) {
+		const ssize_t n = ::read(fd, reply + received, sizeof(reply) - received);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			break;
+		received += n;
+	}
+	::close(fd);
+
+	if (!sent)
+		return -1;
+	if (received < sizeof(reply)) {
+		fprintf(stderr, "guid: the server closed the connection\n");
+		return 1;
 	}
 
-	return fileExists;
+	return int(qFromBigEndian<quint32>(reply));
 }
+#endif
 
 static void setGroup(QGroupBox*& group, QFormLayout*& layout, QLabel* groupLabel, QString& lastGroupName) {
 	if (groupLabel)
@@ -978,73 +2521,94 @@ static void setTabBar(QTabWidget*& tabBar, QFormLayout*& layout, QLabel* tabBarL
 		layout->addRow(tabBar);
 
 	tabBar = new QTabWidget();
-	tabBar->setProperty("guid_tab_bar_verbose", false);
+	editMeta(tabBar).tabBarVerbose = false;
 	tabBar->setStyleSheet(QTABBAR_STYLE);
 	tabName = "";
 	tabIndex = -1;
 }
 
-static void setText(QLabel* text) {
-	QString textTemplate = text->property("guid_text_content").toString();
-	QString textContent = textTemplate;
-	QString defaultTextContent = textTemplate;
+// Returns the content of a marker file, read and parsed again only when its modification
+// time or size changed, or when a change event dropped it from the cache (see
+// dispatchFileChanges()). All the labels using the file share the result.
+static const MarkerSource* markerSource(const QString& filePath) {
+	QFileInfo fileInfo(filePath);
+	const qint64 modified = fileInfo.lastModified().toMSecsSinceEpoch();
+	QHash<QString, MarkerSource>::const_iterator it = gs_markerSources.constFind(filePath);
+	if (it != gs_markerSources.constEnd() && it->modified == modified && it->size == fileInfo.size())
+		return &it.value();
 
-	if (!text->property("guid_text_markers_set").toBool()) {
-		for (int i = 1; i < 10; ++i) {
-			QString propDefMarkerVal = "guid_text_def_marker_val_" + QString::number(i);
-			QString defMarkerVal = text->property(propDefMarkerVal.toStdString().c_str()).toString();
-			if (defMarkerVal.isEmpty())
-				defMarkerVal = "(?)";
-			defaultTextContent.replace("GUID_MARKER_" + QString::number(i), defMarkerVal);
+	QFile file(filePath);
+	if (!file.open(QIODevice::ReadOnly)) {
+		gs_markerSources.remove(filePath);
+		return NULL;
+	}
+	QByteArray content = file.readAll();
+	while (content.right(1) == "\n")
+		content.chop(1);
+
+	MarkerSource source;
+	source.content = QString(content);
+	source.modified = modified;
+	source.size = fileInfo.size();
+	foreach (const QString& line, splitValues(content.constData(), content.size(), "\n", false)) {
+		QString varName = line.section('=', 0, 0);
+		if (!source.vars.contains(varName)) // the first line wins
+			source.vars.insert(varName, line.section('=', 1, 1));
+	}
+
+	return &(gs_markerSources[filePath] = source);
+}
+
+static void setText(QLabel* text) {
+	QString textTemplate = meta(text).textContent;
+	QString textContent = textTemplate;
+	QString defaultTextContent = textTemplate;
+	const WidgetMarkers markers = meta(text).textMarkers;
+	const QMap<int, QString> controlValues = meta(text).textMarkerValues; // --control
+
+	// Highest numbers first so that GUID_MARKER_1 does not eat into GUID_MARKER_10
+	QList<int> markerIds = markers.keys();
+	for (int i = 1; i < 10; ++i) {
+		if (!markers.contains(i))
+			markerIds << i;
+	}
+	std::sort(markerIds.begin(), markerIds.end(), std::greater<int>());
+
+	if (!meta(text).textMarkersSet) {
+		foreach (int i, markerIds) {
+			QString defMarkerVal = markers.value(i).defVal;
+			if (defMarkerVal.isEmpty())
+				defMarkerVal = "(?)";
+			defaultTextContent.replace("GUID_MARKER_" + QString::number(i), defMarkerVal);
 		}
 
 		text->setText(defaultTextContent);
-		text->setProperty("guid_text_markers_set", true);
+		editMeta(text).textMarkersSet = true;
 	}
 
-	for (int i = 1; i < 10; ++i) {
-		QString propDefMarkerVal = "guid_text_def_marker_val_" + QString::number(i);
-		QString defMarkerVal = text->property(propDefMarkerVal.toStdString().c_str()).toString();
+	foreach (int i, markerIds) {
+		const WidgetMarker marker = markers.value(i);
+		QString defMarkerVal = marker.defVal;
 		if (defMarkerVal.isEmpty())
 			defMarkerVal = "(?)";
 
-		QString propMarkerFile = "guid_text_monitor_marker_file_" + QString::number(i);
-		QString filePath = text->property(propMarkerFile.toStdString().c_str()).toString();
-
-		if (!filePath.isEmpty()) {
-			QFile file(filePath);
-			QTextCodec::setCodecForLocale(QTextCodec::codecForName("UTF-8"));
-
-			if (file.open(QIODevice::ReadOnly)) {
-				QByteArray markerValue = file.readAll();
-				while (markerValue.right(1) == "\n")
-					markerValue.chop(1);
-
-				QString newValue = QString(markerValue);
-				QString propMonitorVarName = "guid_text_monitor_var_name_" + QString::number(i);
-				QString monitorVarName = text->property(propMonitorVarName.toStdString().c_str()).toString();
-				bool varFound = false;
-				if (!monitorVarName.isEmpty()) {
-					newValue.replace(QRegExp("[\r\n]+"), "\n");
-					QStringList newValueLines = newValue.split("\n");
-					foreach (QString line, newValueLines) {
-						QString varName = line.section('=', 0, 0);
-						if (varName == monitorVarName) {
-							varFound = true;
-							newValue = line.section('=', 1, 1);
-							break;
-						}
-					}
-					if (!varFound)
-						newValue = "";
-				}
+		QString filePath = marker.file;
+
+		if (controlValues.contains(i)) {
+			QString newValue = controlValues.value(i);
+			textContent.replace("GUID_MARKER_" + QString::number(i), newValue.isEmpty() ? defMarkerVal : newValue);
+		} else if (!filePath.isEmpty()) {
+			const MarkerSource* source = markerSource(filePath);
+			if (source) {
+				QString newValue = source->content;
+				QString monitorVarName = marker.varName;
+				if (!monitorVarName.isEmpty())
+					newValue = source->vars.value(monitorVarName);
 
 				if (newValue.isEmpty())
 					newValue = defMarkerVal;
 
 				textContent.replace("GUID_MARKER_" + QString::number(i), newValue);
-
-				file.close();
 			}
 		}
 	}
@@ -1053,13 +2617,104 @@ static void setText(QLabel* text) {
 		text->setText(textContent);
 }
 
+// Returns the lines appended to a followed file (follow=true) since the previous call for
+// the same widget. A partial last line is kept for the next call while the file grows, and
+// returned once it stopped growing. When the file was truncated or replaced (log rotation),
+// it's read from the start again and restarted is set. Only the last MiB is read the first
+// time.
+static QByteArray readFollowedFile(QObject* widget, const QString& filePath, bool& restarted) {
+	QByteArray content;
+	restarted = false;
+	QFile file(filePath);
+	if (!file.open(QIODevice::ReadOnly))
+		return content;
+
+	qint64 fileId = 0;
+#ifdef Q_OS_UNIX
+	struct stat fileStat;
+	if (fstat(file.handle(), &fileStat) == 0)
+		fileId = qint64(fileStat.st_ino);
+#endif
+	const qint64 size = file.size();
+	qint64 offset = meta(widget).followOffset;
+	if (offset < 0 || size < offset || fileId != meta(widget).followFileId) {
+		restarted = true;
+		offset = 0;
+		if (size > 1024 * 1024 && file.seek(size - 1024 * 1024)) {
+			file.readLine(); // skip the partial line
+			offset = file.pos();
+		}
+	}
+
+	if (size > offset && file.seek(offset)) {
+		content = file.read(size - offset);
+		if (size != meta(widget).followSize)
+			content.truncate(content.lastIndexOf('\n') + 1);
+		offset += content.size();
+	}
+	WidgetMeta& m = editMeta(widget);
+	m.followFileId = fileId;
+	m.followOffset = offset;
+	m.followSize = size;
+
+	return content;
+}
+
+// Reads all the input available on stdin without waiting for more: what is buffered
+// plus what is pending in the pipe
+static QByteArray readAvailableStdIn() {
+#ifdef Q_OS_UNIX
+	qint64 available = gs_stdin->bytesAvailable();
+	int pending = 0;
+	if (ioctl(gs_stdin->handle(), FIONREAD, &pending) == 0)
+		available += pending;
+	return gs_stdin->read(qMax(available, qint64(1))); // 1: nothing pending means the end of the input
+#else
+	return gs_stdin->readLine();
+#endif
+}
+
+// Writes to stdout what it takes without blocking, or everything with wait. Returns the
+// number of bytes written, or -1 when stdout is closed or failing.
+static qint64 writeAvailableStdOut(const char* data, qint64 size, bool wait = false) {
+#ifdef Q_OS_UNIX
+	qint64 written = 0;
+	while (written < size) {
+		struct pollfd pfd;
+		pfd.fd = STDOUT_FILENO;
+		pfd.events = POLLOUT;
+		pfd.revents = 0;
+		const int ready = poll(&pfd, 1, wait ? -1 : 0);
+		if (ready < 0 && errno == EINTR)
+			continue;
+		if (ready <= 0)
+			break;
+		if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL))
+			return -1;
+		// A pipe polled writable takes PIPE_BUF bytes at once
+		const ssize_t n = ::write(STDOUT_FILENO, data + written, size_t(qMin(size - written, qint64(PIPE_BUF))));
+		if (n < 0) {
+			if (errno == EINTR || (errno == EAGAIN && wait))
+				continue;
+			return errno == EAGAIN ? written : -1;
+		}
+		written += n;
+	}
+	return written;
+#else
+	const qint64 written = qint64(fwrite(data, 1, size_t(size), stdout));
+	fflush(stdout);
+	return written;
+#endif
+}
+
 static void setTextInfo(QTextEdit* textInfo) {
-	QString filename = textInfo->property("guid_text_filename").toString();
-	bool isReadOnly = textInfo->property("guid_text_read_only").toBool();
-	bool isUrl = textInfo->property("guid_text_is_url").toBool();
-	QString format = textInfo->property("guid_text_format").toString();
-	QString curlPath = textInfo->property("guid_text_curl_path").toString();
-	int heightToSet = textInfo->property("guid_text_height").toInt();
+	QString filename = meta(textInfo).textFilename;
+	bool isReadOnly = meta(textInfo).textReadOnly;
+	bool isUrl = meta(textInfo).textIsUrl;
+	QString format = meta(textInfo).textFormat;
+	QString curlPath = meta(textInfo).textCurlPath;
+	int heightToSet = meta(textInfo).textHeight;
 
 	textInfo->setReadOnly(isReadOnly);
 	if (textInfo->isReadOnly()) {
@@ -1091,19 +2746,50 @@ static void setTextInfo(QTextEdit* textInfo) {
 			delete curl;
 		});
 		curl->start(curlPath, QStringList() << "-L" << "-s" << filename);
+	} else if (meta(textInfo).follow) {
+		bool restarted;
+		QByteArray content = readFollowedFile(textInfo, filename, restarted);
+		while (content.right(1) == "\n")
+			content.chop(1);
+		if (restarted) {
+			if (format == "html")
+				textInfo->setHtml(QString::fromUtf8(content));
+			else if (format == "plain")
+				textInfo->setPlainText(QString::fromUtf8(content));
+			else
+				textInfo->setText(QString::fromUtf8(content));
+		} else {
+			// Only the new lines are added, and the height is left as it was
+			if (content.isEmpty())
+				return;
+			QString newText = QString::fromUtf8(content);
+			QScrollBar* scrollBar = textInfo->verticalScrollBar();
+			bool atBottom = scrollBar->value() == scrollBar->maximum();
+			QTextCursor cursor(textInfo->document());
+			cursor.movePosition(QTextCursor::End);
+			if (format == "html" || (format != "plain" && Qt::mightBeRichText(newText))) {
+				cursor.insertHtml("<br>" + newText);
+			} else {
+				if (!textInfo->document()->isEmpty())
+					newText.prepend('\n');
+				cursor.insertText(newText);
+			}
+			if (atBottom)
+				scrollBar->setValue(scrollBar->maximum());
+			return;
+		}
 	} else {
 		QFile file(filename);
-		QTextCodec::setCodecForLocale(QTextCodec::codecForName("UTF-8"));
 		if (file.open(QIODevice::ReadOnly)) {
 			QByteArray content = file.readAll();
 			while (content.right(1) == "\n")
 				content.chop(1);
 			if (format == "html")
-				textInfo->setHtml(QString::fromLocal8Bit(content));
+				textInfo->setHtml(QString::fromUtf8(content));
 			else if (format == "plain")
-				textInfo->setPlainText(QString::fromLocal8Bit(content));
+				textInfo->setPlainText(QString::fromUtf8(content));
 			else
-				textInfo->setText(QString::fromLocal8Bit(content));
+				textInfo->setText(QString::fromUtf8(content));
 			file.close();
 		}
 	}
@@ -1131,8 +2817,18 @@ static void setTextInfo(QTextEdit* textInfo) {
 Guid::Guid(int& argc, char** argv)
     : QApplication(argc, argv)
     , m_alwaysOnTop(false)
+    , m_changeInterval(-1)
+    , m_changeNotifier(NULL)
+    , m_changeTimer(NULL)
     , m_closeToSysTray(false)
     , m_dialog(NULL)
+    , m_fileDispatchTimer(NULL)
+    , m_fileWatcher(NULL)
+    , m_inputFlushTimer(NULL)
+    , m_jobPolicy(JobPolicy::Queue)
+    , m_jobTimeout(0)
+    , m_killJobsOnExit(false)
+    , m_maxJobs(4)
     , m_modal(false)
     , m_noTaskbar(false)
     , m_notificationId(0)
@@ -1141,135 +2837,39 @@ Guid::Guid(int& argc, char** argv)
     , m_okKeepOpen(false)
     , m_okValuesToFooter(false)
     , m_parentWindow(0)
+    , m_pendingValue(-1)
+    , m_pollInterval(0)
+    , m_pollRunning(false)
+    , m_pollTimer(NULL)
     , m_prefixErr("")
     , m_prefixOk("")
+    , m_scrollAnimator(NULL)
     , m_selectableLabel(false)
+    , m_serverFd(-1)
+    , m_serverNotifier(NULL)
+    , m_sessionFd(-1)
+    , m_sessionNotifier(NULL)
+    , m_stats(false)
     , m_sysTray(NULL)
     , m_sysTrayMsg(false)
     , m_timeout(0)
+    , m_timeoutTimer(NULL)
     , m_type(Invalid) {
-	QStringList argList = QCoreApplication::arguments(); // arguments() is slow
-	m_zenity = argList.at(0).endsWith("zenity");
-	// make canonical list
-	QStringList args;
-	if (argList.at(0).endsWith("-askpass")) {
-		argList.removeFirst();
-		args << "--title" << tr("Enter Password") << "--password" << "--prompt" << argList.join(' ');
-	} else {
-		for (int i = 1; i < argList.count(); ++i) {
-			if (argList.at(i).startsWith("--")) {
-				int split = argList.at(i).indexOf('=');
-				if (split > -1) {
-					args << argList.at(i).left(split) << argList.at(i).mid(split + 1);
-				} else {
-					args << argList.at(i);
-				}
-			} else {
-				args << argList.at(i);
-			}
-		}
-	}
-	argList.clear();
-
-	if (!readGeneral(args))
-		return;
-
-	char error = 1;
-	foreach (const QString& arg, args) {
-		if (arg == "--calendar") {
-			m_type = Calendar;
-			error = showCalendar(args);
-		} else if (arg == "--entry") {
-			m_type = Entry;
-			error = showEntry(args);
-		} else if (arg == "--error") {
-			m_type = Error;
-			error = showMessage(args, 'e');
-		} else if (arg == "--info") {
-			m_type = Info;
-			error = showMessage(args, 'i');
-		} else if (arg == "--file-selection") {
-			m_type = FileSelection;
-			error = showFileSelection(args);
-		} else if (arg == "--list") {
-			m_type = List;
-			error = showList(args);
-		} else if (arg == "--notification") {
-			m_type = Notification;
-			error = showNotification(args);
-		} else if (arg == "--progress") {
-			m_type = Progress;
-			error = showProgress(args);
-		} else if (arg == "--question") {
-			m_type = Question;
-			error = showMessage(args, 'q');
-		} else if (arg == "--warning") {
-			m_type = Warning;
-			error = showMessage(args, 'w');
-		} else if (arg == "--scale") {
-			m_type = Scale;
-			error = showScale(args);
-		} else if (arg == "--text-info") {
-			m_type = TextInfo;
-			error = showText(args);
-		} else if (arg == "--color-selection") {
-			m_type = ColorSelection;
-			error = showColorSelection(args);
-		} else if (arg == "--font-selection") {
-			m_type = FontSelection;
-			error = showFontSelection(args);
-		} else if (arg == "--password") {
-			m_type = Password;
-			error = showPassword(args);
-		} else if (arg == "--forms") {
-			m_type = Forms;
-			error = showForms(args);
-		}
-		if (error != 1) {
-			break;
-		}
-	}
+	for (int i = 0; i < 3; ++i)
+		m_serverStdFds[i] = -1;
+	qRegisterMetaType<FileSignature>(); // queued to fileParsed()
+	qRegisterMetaType<QSharedPointer<QAtomicInt>>();
+#ifndef QT_NO_DEBUG
+	foreach (const QString& option, optionsWithoutHelp())
+		qWarning().noquote() << "guid: no help for the option" << option;
+#endif
 
-	if (error) {
-		QMetaObject::invokeMethod(this, "exitGuid", Qt::QueuedConnection, Q_ARG(int, 2));
+	QStringList argList = QCoreApplication::arguments(); // arguments() is slow
+	if (argList.count() > 1 && (argList.at(1) == "--server" || argList.at(1).startsWith("--server="))) {
+		startServer(argList.at(1).section('=', 1));
 		return;
 	}
-
-	if (m_dialog) {
-		// close on ctrl+return in addition to ctrl+enter
-		QAction* shortAccept = new QAction(m_dialog);
-		m_dialog->addAction(shortAccept);
-		shortAccept->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_Return));
-		connect(shortAccept, SIGNAL(triggered()), m_dialog, SLOT(accept()));
-
-		// workaround for #21 - since QWidget is now merely bitrot, QDialog closes,
-		// but does not reject on the escape key (unlike announced in the specific section of the API)
-		QAction* shortReject = new QAction(m_dialog);
-		m_dialog->addAction(shortReject);
-		shortReject->setShortcut(QKeySequence(Qt::Key_Escape));
-		connect(shortReject, SIGNAL(triggered()), m_dialog, SLOT(reject()));
-
-		m_dialog->setWindowModality(m_modal ? Qt::ApplicationModal : Qt::NonModal);
-		if (!m_caption.isNull())
-			m_dialog->setWindowTitle(m_caption);
-		if (!m_icon.isNull())
-			m_dialog->setWindowIcon(QIcon(m_icon));
-		QDialogButtonBox* box = m_dialog->findChild<QDialogButtonBox*>();
-		if (box && !m_ok.isNull()) {
-			if (QPushButton* btn = box->button(QDialogButtonBox::Ok))
-				btn->setText(m_ok);
-		}
-		if (box && !m_cancel.isNull()) {
-			if (QPushButton* btn = box->button(QDialogButtonBox::Cancel))
-				btn->setText(m_cancel);
-		}
-		if (m_parentWindow) {
-#ifdef WS_X11
-			m_dialog->setAttribute(Qt::WA_X11BypassTransientForHint);
-			XSetTransientForHint(QX11Info::display(), m_dialog->winId(), m_parentWindow);
-#endif
-		}
-	}
+	run(argList);
 }
 
 void Guid::printHelp(const QString& category) {
@@ -1334,22 +2934,8 @@ void Guid::addListRow() {
 			newItem->setText(i, QString());
 		}
 
-		QWidget* firstItemWidget = list->itemWidget(firstItem, 0);
-		if (firstItemWidget) {
-			if (qstrcmp(firstItemWidget->metaObject()->className(), "QCheckBox") == 0) {
-				QCheckBox* cb = new QCheckBox();
-				cb->setContentsMargins(0, 0, 0, 0);
-				cb->setCheckState(Qt::Unchecked);
-				cb->setStyleSheet("QCheckBox::indicator {subcontrol-position: center center;}");
-				list->setItemWidget(newItem, 0, cb);
-			} else if (qstrcmp(firstItemWidget->metaObject()->className(), "QRadioButton") == 0) {
-				QRadioButton* rb = new QRadioButton();
-				rb->setContentsMargins(0, 0, 0, 0);
-				rb->setChecked(false);
-				rb->setStyleSheet("QRadioButton::indicator {subcontrol-position: center center;}");
-				list->setItemWidget(newItem, 0, rb);
-			}
-		}
+		if (firstItem->data(0, Qt::CheckStateRole).isValid())
+			newItem->setCheckState(0, Qt::Unchecked);
 	}
 }
 
@@ -1361,7 +2947,7 @@ void Guid::afterTabBarClick(int i) {
 			bool disableButtons = false;
 			QTabWidget* tabBar = static_cast<QTabWidget*>(sender());
 			if (tabBar) {
-				disableButtons = tabBar->widget(i)->property("guid_tab_disable_buttons").toBool();
+				disableButtons = meta(tabBar->widget(i)).tabDisableButtons;
 			}
 			buttons->setEnabled(!disableButtons);
 		}
@@ -1376,10 +2962,10 @@ void Guid::afterMenuClick() {
 	QOUT
 
 	    QString menuItemName
-	    = sender()->property("guid_menu_item_name").toString();
-	int menuItemExitCode = sender()->property("guid_menu_item_exit_code").toInt();
-	QString menuItemCommand = sender()->property("guid_menu_item_command").toString();
-	bool menuItemCommandPrintOutput = sender()->property("guid_menu_item_command_print_output").toBool();
+	    = meta(sender()).menuItemName;
+	int menuItemExitCode = meta(sender()).menuItemExitCode;
+	QString menuItemCommand = meta(sender()).menuItemCommand;
+	bool menuItemCommandPrintOutput = meta(sender()).menuItemCommandPrintOutput;
 
 	QString output = QString("%1MENU_CLICKED_DATA_START|name=%2|exitCode=%3|command=%4|commandPrintOutput=%5|commandOutput=")
 	                     .arg(m_prefixOk)
@@ -1398,17 +2984,16 @@ void Guid::afterMenuClick() {
 		QStringList commandArgs = menuItemCommand.split("<>");
 		QString commandExec = commandArgs[0];
 		commandArgs.removeFirst();
-		QProcess* process = new QProcess;
 
 		bool guidShowMsg = false;
-		QMessageBox* guidMsgBox = new QMessageBox();
-		Qt::WindowFlags flags = guidMsgBox->windowFlags();
-		flags |= Qt::WindowStaysOnTopHint;
-		guidMsgBox->setWindowFlags(flags);
+		QMessageBox* guidMsgBox = NULL;
 		QString guidMsg = "";
 
 		if (commandExec == "guidInfo" || commandExec == "guidWarning" || commandExec == "guidError") {
 			guidShowMsg = true;
+			guidMsgBox = new QMessageBox();
+			guidMsgBox->setAttribute(Qt::WA_DeleteOnClose);
+			guidMsgBox->setWindowFlags(guidMsgBox->windowFlags() | Qt::WindowStaysOnTopHint);
 			guidMsgBox->setWindowTitle(menuItemName);
 			guidMsgBox->setTextInteractionFlags(Qt::LinksAccessibleByMouse | Qt::TextSelectableByMouse);
 
@@ -1428,29 +3013,25 @@ void Guid::afterMenuClick() {
 				qOut << guidMsg << "|MENU_CLICKED_DATA_END" << Qt::endl;
 				guidMsgBox->show();
 			} else {
-				connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), [=]() {
-					QString commandOutput = QString::fromLocal8Bit(process->readAllStandardOutput());
-					QOUT
-					        qOut
-					    << commandOutput << "|MENU_CLICKED_DATA_END";
-					delete process;
-				});
-				process->start(commandExec, commandArgs);
 				qOut << Qt::endl;
+				Job job;
+				job.program = commandExec;
+				job.args = commandArgs;
+				job.output = Job::MenuOutput;
+				queueJob(job);
 			}
 		} else if (guidShowMsg) {
 			guidMsgBox->show();
 		} else {
-			process->startDetached(commandExec, commandArgs);
+			Job job;
+			job.program = commandExec;
+			job.args = commandArgs;
+			queueJob(job);
 		}
 	}
 
-	if (menuItemExitCode >= 0 && menuItemExitCode <= 255) {
-		QSystemTrayIcon* sysTrayIcon = static_cast<QSystemTrayIcon*>(m_sysTray);
-		if (sysTrayIcon)
-			sysTrayIcon->hide();
-		exit(menuItemExitCode);
-	}
+	if (menuItemExitCode >= 0 && menuItemExitCode <= 255)
+		exitGuid(menuItemExitCode);
 }
 
 void Guid::dialogFinished(int status) {
@@ -1469,7 +3050,7 @@ void Guid::dialogFinished(int status) {
 
 	if (!(status == QDialog::Accepted || status == QMessageBox::Ok || status == QMessageBox::Yes)) {
 #ifdef Q_OS_UNIX
-		if (sender()->property("guid_autokill_parent").toBool()) {
+		if (meta(sender()).autoKillParent) {
 			::kill(getppid(), 15);
 		}
 #endif
@@ -1487,10 +3068,11 @@ void Guid::dialogFinished(int status) {
 	case Info:
 	case Error:
 	case Progress:
+	case MultiProgress:
 	case Notification:
 		break;
 	case Calendar: {
-		QString dateFormat = sender()->property("guid_date_format").toString();
+		QString dateFormat = meta(sender()).dateFormat;
 		QDate date = sender()->findChild<QCalendarWidget*>()->selectedDate();
 		if (dateFormat.isEmpty())
 			qOut << m_prefixOk + QLocale::system().toString(date, QLocale::ShortFormat) << Qt::endl;
@@ -1522,7 +3104,7 @@ void Guid::dialogFinished(int status) {
 	}
 	case FileSelection: {
 		QStringList files = static_cast<QFileDialog*>(sender())->selectedFiles();
-		qOut << m_prefixOk + files.join(sender()->property("guid_separator").toString()) << Qt::endl;
+		qOut << m_prefixOk + files.join(meta(sender()).separator) << Qt::endl;
 		break;
 	}
 	case ColorSelection: {
@@ -1558,7 +3140,7 @@ void Guid::dialogFinished(int status) {
 		else if (fnt.style() == QFont::StyleOblique)
 			slant = "oblique";
 
-		QString font = sender()->property("guid_fontpattern").toString();
+		QString font = meta(sender()).fontPattern;
 		font = font.arg(fnt.family()).arg(size).arg(weight).arg(slant);
 		qOut << m_prefixOk + font << Qt::endl;
 		break;
@@ -1579,72 +3161,33 @@ void Guid::dialogFinished(int status) {
 	}
 	case List: {
 		QTreeWidget* tw = sender()->findChild<QTreeWidget*>();
-		QStringList result;
-		if (tw) {
-			if (tw->selectionMode() == QAbstractItemView::NoSelection)
-				break;
-
-			QString rowValue;
-			QString printColumn = tw->property("guid_list_print_column").toString();
-			QString printMode = tw->property("guid_list_print_values_mode").toString();
-			QString selectionType = tw->property("guid_list_selection_type").toString();
-			QList<QTreeWidgetItem*> itemsToCheck;
-
-			if (selectionType == "checklist" || selectionType == "radiolist" || printMode == "all") {
-				for (int i = 0; i < tw->topLevelItemCount(); ++i) {
-					QTreeWidgetItem* item = tw->topLevelItem(i);
-					itemsToCheck << item;
-				}
-			} else {
-				itemsToCheck = tw->selectedItems();
-			}
-
-			if (selectionType == "checklist" || selectionType == "radiolist") {
-				bool isChecked = false;
-				foreach (QTreeWidgetItem* twi, itemsToCheck) {
-					if (selectionType == "checklist") {
-						QCheckBox* cb = qobject_cast<QCheckBox*>(tw->itemWidget(twi, 0));
-						isChecked = cb->isChecked();
-					} else if (selectionType == "radiolist") {
-						QRadioButton* rb = qobject_cast<QRadioButton*>(tw->itemWidget(twi, 0));
-						isChecked = rb->isChecked();
-					}
+		if (tw && tw->selectionMode() == QAbstractItemView::NoSelection)
+			break;
 
-					if (isChecked || printMode == "all") {
-						rowValue = "";
-						for (int i = 0; i < tw->columnCount(); ++i) {
-							if (printColumn == "all" || printColumn == QString::number(i + 1)) {
-								if (i > 0)
-									rowValue += ',';
-
-								if (i == 0) {
-									if (isChecked)
-										rowValue += "true";
-									else
-										rowValue += "false";
-								} else {
-									rowValue += twi->text(i);
-								}
-							}
-						}
-						result << rowValue;
-					}
-				}
-			} else {
-				foreach (QTreeWidgetItem* twi, itemsToCheck) {
-					rowValue = "";
-					for (int i = 0; i < tw->columnCount(); ++i) {
-						if (printColumn == "all" || printColumn == QString::number(i + 1)) {
-							if (i > 0)
-								rowValue += ',';
-							rowValue += twi->text(i);
-						}
-					}
-					result << rowValue;
-				}
-			}
+		// json: an array of rows; nul: rows terminated by a NUL; shell: a single-quoted word
+		const OutputFormat format = meta(sender()).outputFormat;
+		QString rowSeparator = meta(sender()).separator;
+		if (format == OutputFormat::Nul)
+			rowSeparator = QChar(0);
+		else if (format == OutputFormat::Shell)
+			rowSeparator = "\n";
+
+		QString result = m_prefixOk;
+		if (format == OutputFormat::Shell)
+			result += '\'';
+		const int rows = tw ? appendListRows(result, tw, format, rowSeparator) : 0;
+		if (format == OutputFormat::Json && !tw)
+			result += QLatin1String("[]");
+		else if (format == OutputFormat::Shell)
+			result += '\'';
+
+		if (format == OutputFormat::Nul) {
+			if (rows > 0)
+				result += QChar(0);
+			qOut << result << Qt::flush;
+		} else {
+			qOut << result << Qt::endl;
 		}
-		qOut << m_prefixOk + result.join(sender()->property("guid_separator").toString()) << Qt::endl;
 		break;
 	}
 	case Forms: {
@@ -1658,6 +3201,86 @@ void Guid::dialogFinished(int status) {
 	exitGuid(0);
 }
 
+void Guid::dispatchFileChanges() {
+	const QSet<QString> changedFiles = m_changedFiles;
+	m_changedFiles.clear();
+
+	foreach (const QString& filePath, changedFiles) {
+		// The way the file was edited is not known. Some editors delete the file (event
+		// "IN_DELETE_SELF") or rename a new one over it (event "IN_MOVED_TO"), so the
+		// watcher stops monitoring it. If the file is not back yet, the watch on its
+		// directory reports it when it reappears (see directoryChanged()).
+		if (!m_fileSubscribers.contains(filePath) || !QFile::exists(filePath))
+			continue;
+		m_fileWatcher->addPath(filePath);
+
+		// An edit keeping the size within the modification time resolution would be missed
+		// by the cache of markerSource()
+		gs_markerSources.remove(filePath);
+
+		// Only the widgets subscribed to this file are refreshed
+		foreach (const FileSubscriber& subscriber, m_fileSubscribers.value(filePath)) {
+			switch (subscriber.second) {
+			case WatchCombo:
+				parseFile(subscriber.first, filePath, "\n");
+				break;
+			case WatchFooter:
+				if (meta(subscriber.first).follow)
+					updateFooterContentFromFile(static_cast<QGroupBox*>(subscriber.first), filePath);
+				else
+					parseFile(subscriber.first, filePath, "\n");
+				break;
+			case WatchList: {
+				QString fileSep = meta(subscriber.first).fileSep;
+				parseFile(subscriber.first, filePath, fileSep.isEmpty() ? "\n" : fileSep);
+				break;
+			}
+			case WatchText:
+				setText(static_cast<QLabel*>(subscriber.first));
+				break;
+			case WatchTextInfo:
+				setTextInfo(static_cast<QTextEdit*>(subscriber.first));
+				break;
+			}
+
+			// A partial last line held back by readFollowedFile() is shown once the file
+			// stops growing: the file is read again after a while.
+			if (meta(subscriber.first).follow && meta(subscriber.first).followOffset < meta(subscriber.first).followSize)
+				QTimer::singleShot(250, this, [=]() { fileChanged(filePath); });
+		}
+	}
+}
+
+void Guid::directoryChanged(const QString& dirPath) {
+	// Files replaced or recreated in the directory must be watched again
+	const QStringList watchedFiles = m_fileWatcher->files();
+	foreach (const QString& filePath, m_watchedDirs.value(dirPath)) {
+		if (!watchedFiles.contains(filePath) && QFile::exists(filePath))
+			fileChanged(filePath);
+	}
+}
+
+// --emit-changes: moves the fields that did not change for the interval to the ready list
+void Guid::emitFieldChanges() {
+	const qint64 now = m_changeClock.elapsed();
+	qint64 nextDue = -1;
+	QHash<const QObject*, qint64>::iterator it = m_changeTimes.begin();
+	while (it != m_changeTimes.end()) {
+		const qint64 due = it.value() + m_changeInterval;
+		if (due <= now) {
+			if (!m_readyChanges.contains(it.key()))
+				m_readyChanges << it.key();
+			it = m_changeTimes.erase(it);
+		} else {
+			nextDue = nextDue < 0 ? due : qMin(nextDue, due);
+			++it;
+		}
+	}
+	if (nextDue > -1)
+		m_changeTimer->start(int(nextDue - now));
+	writeFieldChanges();
+}
+
 void Guid::exitGuid(int exitCode, bool minimize) {
 	if (minimize) {
 		// Cancel the exit process
@@ -1670,14 +3293,62 @@ void Guid::exitGuid(int exitCode, bool minimize) {
 		QSystemTrayIcon* sysTrayIcon = static_cast<QSystemTrayIcon*>(m_sysTray);
 		if (sysTrayIcon)
 			sysTrayIcon->hide();
-		exit(exitCode);
+		stopJobs();
+		if (m_serverFd > -1)
+			finishSession(exitCode); // keep the server running
+		else
+			exit(exitCode);
+	}
+}
+
+void Guid::fieldChanged() {
+	if (!m_changeFields.contains(sender()))
+		return;
+	// Debounced per field: the event waits until the field is left unchanged for the interval
+	m_changeTimes.insert(sender(), m_changeClock.elapsed());
+	if (!m_changeTimer->isActive())
+		m_changeTimer->start(m_changeInterval);
+}
+
+void Guid::fileChanged(const QString& filePath) {
+	// Editors often write a file in several steps: the reload waits for the burst to
+	// settle, but a file written continuously is still reloaded every 250 ms.
+	m_changedFiles.insert(filePath);
+	if (!m_fileDispatchTimer->isActive())
+		m_fileBurstTime.start();
+	if (m_fileBurstTime.elapsed() < 250)
+		m_fileDispatchTimer->start();
+}
+
+void Guid::fileParsed(QObject* widget, QSharedPointer<QAtomicInt> latest, int generation, const FileSignature& signature, bool changed, const QStringList& values) {
+	if (m_parseGenerations.value(widget) != latest || latest->loadAcquire() != generation)
+		return; // superseded by a newer change, or the widget is gone
+
+	if (QTreeWidget* tw = qobject_cast<QTreeWidget*>(widget)) {
+		editMeta(tw).listSignature = signature;
+		if (changed) // not only touched
+			updateList(tw, values);
+	} else if (QComboBox* combo = qobject_cast<QComboBox*>(widget)) {
+		updateCombo(combo, values);
+	} else if (QGroupBox* footer = qobject_cast<QGroupBox*>(widget)) {
+		for (int i = values.count() - 1; i >= 0; --i) {
+			updateFooterContent(footer, values.at(i));
+		}
+	}
+}
+
+void Guid::filesPolled(const QStringList& changedFiles) {
+	m_pollRunning = false;
+	foreach (const QString& filePath, changedFiles) {
+		if (m_fileSubscribers.contains(filePath))
+			fileChanged(filePath);
 	}
 }
 
 void Guid::finishProgress() {
 	Q_ASSERT(m_type == Progress);
 	QProgressDialog* dlg = static_cast<QProgressDialog*>(m_dialog);
-	if (dlg->property("guid_autoclose").toBool())
+	if (meta(dlg).autoClose)
 		QTimer::singleShot(250, this, SLOT(quitDialog()));
 	else {
 		dlg->setRange(0, 101);
@@ -1690,6 +3361,20 @@ void Guid::finishProgress() {
 	}
 }
 
+void Guid::flushInput() {
+	if (!m_dialog)
+		return;
+
+	if (m_type == List)
+		updateListRows();
+	else if (m_type == MultiProgress)
+		updateMultiProgress();
+	else if (m_type == Progress)
+		updateProgress();
+	else if (m_type == TextInfo)
+		updateTextInfo();
+}
+
 void Guid::listMenu(const QPoint& pos) {
 	QTreeWidget* tw = static_cast<QTreeWidget*>(sender());
 	if (!tw)
@@ -1740,10 +3425,31 @@ void Guid::minimizeDialog() {
 	}
 }
 
+void Guid::pollFiles() {
+	if (m_pollRunning)
+		return; // the previous batch is still being checked
+
+	// Files due before the next tick are checked now
+	const qint64 now = QDateTime::currentMSecsSinceEpoch() + m_pollTimer->interval() / 2;
+	QStringList dueFiles;
+	for (QHash<QString, QPair<int, qint64>>::iterator it = m_polledFiles.begin(); it != m_polledFiles.end(); ++it) {
+		if (it->second <= now) {
+			dueFiles << it.key();
+			it->second = now + it->first;
+		}
+	}
+	if (dueFiles.isEmpty())
+		return;
+
+	if (!m_pollStamps)
+		m_pollStamps.reset(new QHash<QString, QPair<qint64, qint64>>);
+	m_pollRunning = true;
+	QThreadPool::globalInstance()->start(new FilePoller(this, dueFiles, m_pollStamps));
+}
+
 void Guid::printFormsAfterOKClick() {
 	QFileDialog* dialog = static_cast<QFileDialog*>(m_dialog);
 	QGroupBox* footer = dialog->findChild<QGroupBox*>("dialogFooter", Qt::FindDirectChildrenOnly);
-	bool ok;
 
 	// Print current forms values
 	QString values = printForms();
@@ -1765,16 +3471,24 @@ void Guid::printFormsAfterOKClick() {
 
 	QList<QCheckBox*> cb = dialog->findChildren<QCheckBox*>();
 	foreach (QCheckBox* cbi, cb) {
-		if (cbi->property("guid_checkbox_default").toString() == "checked")
+		if (meta(cbi).checkboxDefault)
 			cbi->setCheckState(Qt::Checked);
 		else
 			cbi->setCheckState(Qt::Unchecked);
 	}
 
+	QList<QTreeWidget*> lists = dialog->findChildren<QTreeWidget*>();
+	foreach (QTreeWidget* list, lists) {
+		if (meta(list).listSelectionType == "checklist") {
+			for (int i = 0; i < list->topLevelItemCount(); ++i)
+				list->topLevelItem(i)->setCheckState(0, Qt::Unchecked);
+		}
+	}
+
 	QList<QComboBox*> combos = dialog->findChildren<QComboBox*>();
 	foreach (QComboBox* combo, combos) {
-		int defaultComboIndex = combo->property("guid_combo_default_index").toInt(&ok);
-		if (ok && defaultComboIndex >= 0 && defaultComboIndex < combo->count())
+		int defaultComboIndex = meta(combo).comboDefaultIndex;
+		if (defaultComboIndex >= 0 && defaultComboIndex < combo->count())
 			combo->setCurrentIndex(defaultComboIndex);
 		else
 			combo->setCurrentIndex(-1);
@@ -1782,8 +3496,8 @@ void Guid::printFormsAfterOKClick() {
 
 	QList<QSlider*> scales = dialog->findChildren<QSlider*>();
 	foreach (QSlider* scale, scales) {
-		int defaultScaleValue = scale->property("guid_scale_default").toInt(&ok);
-		if (ok && defaultScaleValue != INT_MIN)
+		int defaultScaleValue = meta(scale).scaleDefault;
+		if (defaultScaleValue != INT_MIN)
 			scale->setValue(defaultScaleValue);
 		else
 			scale->setValue(scale->minimum());
@@ -1791,8 +3505,8 @@ void Guid::printFormsAfterOKClick() {
 
 	QList<QSpinBox*> spinBoxes = dialog->findChildren<QSpinBox*>();
 	foreach (QSpinBox* spinBox, spinBoxes) {
-		int defaultSpinBoxValue = spinBox->property("guid_spin_box_default").toInt(&ok);
-		if (ok && defaultSpinBoxValue != INT_MIN)
+		int defaultSpinBoxValue = meta(spinBox).spinBoxDefault;
+		if (defaultSpinBoxValue != INT_MIN)
 			spinBox->setValue(defaultSpinBoxValue);
 		else
 			spinBox->setValue(spinBox->minimum());
@@ -1800,8 +3514,8 @@ void Guid::printFormsAfterOKClick() {
 
 	QList<QDoubleSpinBox*> doubleSpinBoxes = dialog->findChildren<QDoubleSpinBox*>();
 	foreach (QDoubleSpinBox* doubleSpinBox, doubleSpinBoxes) {
-		int defaultDoubleSpinBoxValue = doubleSpinBox->property("guid_double_spin_box_default").toDouble(&ok);
-		if (ok && defaultDoubleSpinBoxValue != -DBL_MAX)
+		double defaultDoubleSpinBoxValue = meta(doubleSpinBox).doubleSpinBoxDefault;
+		if (defaultDoubleSpinBoxValue != -DBL_MAX)
 			doubleSpinBox->setValue(defaultDoubleSpinBoxValue);
 		else
 			doubleSpinBox->setValue(doubleSpinBox->minimum());
@@ -1827,20 +3541,19 @@ void Guid::printFormsAfterOKClick() {
 
 		QStringList commandArgs = command.split("<>");
 
-		QString commandExec = commandArgs.at(0);
-		commandArgs.removeAt(0);
-		QProcess* process = new QProcess;
-
-		if (m_okCommandToFooter && footer) {
-			connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), [=]() {
-				QString commandOutput = QString::fromLocal8Bit(process->readAllStandardOutput());
-				updateFooterContent(footer, commandOutput.trimmed());
-
-				delete process;
-			});
-			process->start(commandExec, commandArgs);
-		} else {
-			process->startDetached(commandExec, commandArgs);
+		Job job;
+		job.program = commandArgs.at(0);
+		job.args = commandArgs.mid(1);
+		if (m_okKeepOpen) {
+			if (m_okCommandToFooter && footer) {
+				job.output = Job::FooterOutput;
+				job.footer = footer;
+			}
+			queueJob(job);
+		} else if (QProcess::startDetached(job.program, job.args)) {
+			// The dialog exits right after: the command runs on its own, with nothing left
+			// to show its output or to kill it
+			m_jobStats.started++;
 		}
 	}
 
@@ -1860,24 +3573,128 @@ void Guid::quitDialog() {
 
 void Guid::readStdIn() {
 	QOUT_ERR
-	if (!gs_stdin->isOpen())
+	if (!gs_stdin || !gs_stdin->isOpen())
 		return;
 	QSocketNotifier* notifier = qobject_cast<QSocketNotifier*>(sender());
 	if (notifier)
 		notifier->setEnabled(false);
 
-	QByteArray ba = m_type == TextInfo ? gs_stdin->readAll() : gs_stdin->readLine();
+	QByteArray ba;
+	if (m_type == TextInfo)
+		ba = gs_stdin->readAll();
+	else if (m_type == Progress || m_type == MultiProgress || m_type == List || m_type == Forms)
+		ba = readAvailableStdIn();
+	else
+		ba = gs_stdin->readLine();
 	if (ba.isEmpty() && notifier) {
 		gs_stdin->close();
 		//gs_stdin->deleteLater(); // hello segfault...
 		//gs_stdin = NULL;
 		notifier->deleteLater();
+		// The dialog is finished after the last updates; the HTML held back by
+		// updateTextInfo() is inserted
+		if (m_type == MultiProgress || m_type == TextInfo)
+			startInputFlush();
+		if (m_pendingInput.isEmpty() || (m_type != Progress && m_type != MultiProgress && m_type != List && m_type != Forms))
+			return;
+		if (!m_pendingInput.endsWith('\n'))
+			ba = "\n"; // the last line has no line break
+		notifier = NULL;
+	}
+
+	if (m_type == MultiProgress) {
+		// "job:value" and "job:#label" lines; only the last label and value of each job
+		// are shown, once per frame
+		m_pendingInput += ba;
+		int start = 0;
+		for (int end = m_pendingInput.indexOf('\n'); end > -1; end = m_pendingInput.indexOf('\n', start)) {
+			const char* colon = static_cast<const char*>(memchr(m_pendingInput.constData() + start, ':', end - start));
+			const int split = colon ? colon - m_pendingInput.constData() : -1;
+			if (split > start) {
+				const QString job = QString::fromLocal8Bit(m_pendingInput.constData() + start, split - start).trimmed();
+				int j = m_pendingJobs.count() - 1;
+				while (j > -1 && m_pendingJobs.at(j).job != job)
+					--j;
+				if (j < 0) {
+					ProgressUpdate update;
+					update.job = job;
+					m_pendingJobs << update;
+					j = m_pendingJobs.count() - 1;
+				}
+				ProgressUpdate& update = m_pendingJobs[j];
+
+				const char* line = m_pendingInput.constData() + split + 1;
+				const int length = end - split - 1;
+				if (length > 0 && line[0] == '#') {
+					update.label = QString::fromLocal8Bit(line + 1, length - 1);
+				} else {
+					int value = -1;
+					for (int k = 0; k < length && line[k] >= '0' && line[k] <= '9'; ++k)
+						value = qMin(100, qMax(value, 0) * 10 + (line[k] - '0'));
+					if (value > -1)
+						update.value = value;
+				}
+			}
+			start = end + 1;
+		}
+		m_pendingInput.remove(0, start);
+
+		startInputFlush();
+		if (notifier)
+			notifier->setEnabled(true);
+		return;
+	}
+
+	if (m_type == Forms) {
+		// --control=stdin: the complete lines read at once are a batch
+		m_pendingInput += ba;
+		const int end = m_pendingInput.lastIndexOf('\n');
+		if (end > -1) {
+			runControlCommands(m_pendingInput.left(end));
+			m_pendingInput.remove(0, end + 1);
+		}
+		if (notifier)
+			notifier->setEnabled(true);
+		return;
+	}
+
+	if (m_type == List) {
+		// The rows are added once per frame, in batches
+		m_pendingInput += ba;
+		startInputFlush();
+		if (notifier)
+			notifier->setEnabled(true);
+		return;
+	}
+
+	if (m_type == Progress) {
+		// Only the last label and value read are shown, once per frame
+		m_pendingInput += ba;
+		int start = 0;
+		for (int end = m_pendingInput.indexOf('\n'); end > -1; end = m_pendingInput.indexOf('\n', start)) {
+			const char* line = m_pendingInput.constData() + start;
+			const int length = end - start;
+			if (length > 0 && line[0] == '#') {
+				m_pendingLabel = QString::fromLocal8Bit(line + 1, length - 1);
+			} else {
+				int value = -1;
+				for (int k = 0; k < length && line[k] >= '0' && line[k] <= '9'; ++k)
+					value = qMin(100, qMax(value, 0) * 10 + (line[k] - '0'));
+				if (value > -1)
+					m_pendingValue = value;
+			}
+			start = end + 1;
+		}
+		m_pendingInput.remove(0, start);
+
+		startInputFlush();
+		if (notifier)
+			notifier->setEnabled(true);
 		return;
 	}
 
-	static QString cachedText;
 	QString newText = QString::fromLocal8Bit(ba);
-	if (newText.isEmpty() && cachedText.isEmpty()) {
+	if (newText.isEmpty() && m_cachedText.isEmpty()) {
 		if (notifier)
 			notifier->setEnabled(true);
 		return;
@@ -1889,69 +3706,10 @@ void Guid::readStdIn() {
 			newText.resize(newText.length() - 1);
 		input = newText.split('\n');
 	}
-	if (m_type == Progress) {
-		QProgressDialog* dlg = static_cast<QProgressDialog*>(m_dialog);
-
-		const int oldValue = dlg->value();
-		bool ok;
-		foreach (QString line, input) {
-			if (line.startsWith('#')) {
-				dlg->setLabelText(labelText(line.mid(1)));
-			} else {
-				static const QRegularExpression nondigit("[^0-9]");
-				int u = line.section(nondigit, 0, 0).toInt(&ok);
-				if (ok)
-					dlg->setValue(qMin(100, u));
-			}
-		}
-
-		if (dlg->maximum() == 0)
-			return; // we just need the label support
-
-		if (dlg->value() == 100) {
-			finishProgress();
-		} else if (oldValue == 100) {
-			disconnect(dlg, SIGNAL(canceled()), dlg, SLOT(accept()));
-			connect(dlg, SIGNAL(canceled()), dlg, SLOT(reject()));
-			dlg->setCancelButtonText(m_cancel.isNull() ? tr("Cancel") : m_cancel);
-		} else if (dlg->property("guid_eta").toBool()) {
-			static QDateTime starttime;
-			if (starttime.isNull()) {
-				starttime = QDateTime::currentDateTime();
-			} else if (dlg->value() > 0) {
-				const qint64 secs = starttime.secsTo(QDateTime::currentDateTime());
-				QString eta = QTime(0, 0, 0).addSecs(100 * secs / dlg->value() - secs).toString();
-				foreach (QWidget* w, dlg->findChildren<QWidget*>())
-					w->setToolTip(eta);
-			}
-		}
-	} else if (m_type == TextInfo) {
-		if (QTextEdit* te = m_dialog->findChild<QTextEdit*>()) {
-			cachedText += newText;
-			static QPropertyAnimation* animator = NULL;
-			if (!animator || animator->state() != QPropertyAnimation::Running) {
-				const int oldValue = te->verticalScrollBar() ? te->verticalScrollBar()->value() : 0;
-				if (te->property("guid_html").toBool())
-					te->setHtml(te->toHtml() + cachedText);
-				else
-					te->setPlainText(te->toPlainText() + cachedText);
-				cachedText.clear();
-				if (te->verticalScrollBar() && te->property("guid_autoscroll").toBool()) {
-					te->verticalScrollBar()->setValue(oldValue);
-					if (!animator) {
-						animator = new QPropertyAnimation(te->verticalScrollBar(), "value", this);
-						animator->setEasingCurve(QEasingCurve::InOutCubic);
-						connect(animator, SIGNAL(finished()), SLOT(readStdIn()));
-					}
-					const int diff = te->verticalScrollBar()->maximum() - oldValue;
-					if (diff > 0) {
-						animator->setDuration(qMin(qMax(200, diff), 2500));
-						animator->setEndValue(te->verticalScrollBar()->maximum());
-						animator->start();
-					}
-				}
-			}
-		}
+	if (m_type == TextInfo) {
+		// The text is added once per frame at most, however fast it comes
+		m_cachedText += newText;
+		startInputFlush();
 	} else if (m_type == Notification) {
 		bool userNeedsHelp = true;
 		foreach (QString line, input) {
@@ -1977,16 +3735,62 @@ void Guid::readStdIn() {
 		}
 		if (userNeedsHelp)
 			qOutErr << m_prefixErr + "icon: <filename>\nmessage: <UTF-8 encoded text>\ntooltip: <UTF-8 encoded text>\nvisible: <true|false>" << Qt::endl;
-	} else if (m_type == List) {
-		if (QTreeWidget* tw = m_dialog->findChild<QTreeWidget*>()) {
-			const int twflags = tw->property("guid_list_flags").toInt();
-			addItems(tw, input, twflags & 1, twflags & 1 << 1, twflags & 1 << 2);
-		}
 	}
 	if (notifier)
 		notifier->setEnabled(true);
 }
 
+void Guid::serverAccept() {
+#ifdef Q_OS_UNIX
+	if (m_sessionFd > -1)
+		return; // one dialog at a time; other clients wait in the listen queue
+
+	int fd = ::accept(m_serverFd, NULL, NULL);
+	if (fd < 0)
+		return;
+	if (!peerIsSameUser(fd)) {
+		::close(fd);
+		return;
+	}
+	fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+	int stdFds[3];
+	QString cwd;
+	QStringList argList;
+	if (!readClientRequest(fd, stdFds, cwd, argList)) {
+		::close(fd);
+		return;
+	}
+
+	m_serverNotifier->setEnabled(false);
+	m_sessionFd = fd;
+	m_sessionNotifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+	connect(m_sessionNotifier, SIGNAL(activated(int)), SLOT(serverClientClosed()));
+
+	// The dialog talks to the client through its own standard streams
+	fflush(stdout);
+	fflush(stderr);
+	for (int i = 0; i < 3; ++i) {
+		dup2(stdFds[i], i);
+		::close(stdFds[i]);
+	}
+	clearerr(stdin);
+	QDir::setCurrent(cwd);
+
+	resetSession();
+	run(argList);
+#endif
+}
+
+void Guid::serverClientClosed() {
+#ifdef Q_OS_UNIX
+	// The client never writes after its request, so readability means it went away
+	char c;
+	if (m_sessionFd > -1 && ::read(m_sessionFd, &c, 1) <= 0)
+		finishSession(1);
+#endif
+}
+
 void Guid::showDialog() {
 	QDialog* dlg = static_cast<QDialog*>(m_dialog);
 	if (dlg) {
@@ -2022,152 +3826,72 @@ void Guid::toggleItems(QTreeWidgetItem* item, int column) {
 	recursion = false;
 }
 
-void Guid::updateCombo(QString filePath) {
-	if (!QFile::exists(filePath))
-		return;
+void Guid::unwatchFiles(QObject* widget) {
+	QSharedPointer<QAtomicInt> latest = m_parseGenerations.take(widget);
+	if (latest)
+		latest->storeRelease(-1);
+
+	foreach (const QString& filePath, m_watchedFiles.take(widget)) {
+		QList<FileSubscriber>& subscribers = m_fileSubscribers[filePath];
+		for (int i = subscribers.count() - 1; i >= 0; --i) {
+			if (subscribers.at(i).first == widget)
+				subscribers.removeAt(i);
+		}
+		if (subscribers.isEmpty()) {
+			m_fileSubscribers.remove(filePath);
+			m_fileWatcher->removePath(filePath);
+			if (m_polledFiles.remove(filePath) && m_polledFiles.isEmpty()) {
+				m_pollTimer->stop();
+				m_pollStamps.reset();
+			}
 
-	foreach (QComboBox* combo, sender()->parent()->findChildren<QComboBox*>()) {
-		if (combo->property("guid_monitor_file").toBool() && combo->property("guid_file_path").toString() == filePath) {
-			combo->clear();
-			GList list = listValuesFromFile(filePath);
-			combo->addItems(list.val);
-			bool ok;
-			int currentIndex = combo->property("guid_combo_default_index").toInt(&ok);
-			if (ok && currentIndex > 0 && currentIndex < combo->count()) {
-				combo->setCurrentIndex(currentIndex);
+			const QString dirPath = QFileInfo(filePath).absolutePath();
+			QStringList& dirFiles = m_watchedDirs[dirPath];
+			dirFiles.removeAll(filePath);
+			if (dirFiles.isEmpty()) {
+				m_watchedDirs.remove(dirPath);
+				m_fileWatcher->removePath(dirPath);
 			}
 		}
 	}
 }
 
-void Guid::updateFooter(QString filePath) {
-	if (!QFile::exists(filePath))
-		return;
-
-	QDialog* dlg = static_cast<QDialog*>(m_dialog);
-	if (!dlg)
-		return;
-
-	QGroupBox* footer = dlg->findChild<QGroupBox*>("dialogFooter", Qt::FindDirectChildrenOnly);
-	if (!footer)
-		return;
-
-	updateFooterContentFromFile(footer, filePath);
-}
-
-void Guid::updateList(QString filePath) {
-	// The file containing list values has been updated. However, the way it was edited is not known.
-	// Some editors delete the file (event "IN_DELETE_SELF") to replace it with new content, so the
-	// watcher will stop monitoring the file. Here's the workaround: wait some time before testing if
-	// the file exists, then add it again to the watcher.
-	bool pathExists = pathTester(filePath);
-	if (!pathExists)
-		return;
-	QFileSystemWatcher* watcher = static_cast<QFileSystemWatcher*>(sender());
-	watcher->addPath(filePath);
-
-	foreach (QTreeWidget* tw, watcher->parent()->findChildren<QTreeWidget*>()) {
-		bool propMonitorFile = tw->property("guid_monitor_file").toBool();
-		QString propFilePath = tw->property("guid_file_path").toString();
-		QString propSelectionType = tw->property("guid_list_selection_type").toString();
-		QString propAddValue = tw->property("guid_list_add_value").toString();
-		QString propFileSep = tw->property("guid_file_sep").toString();
-
-		if (propMonitorFile && propFilePath == filePath) {
-			int columnCount = tw->columnCount();
-			Qt::ItemFlags flags = tw->topLevelItem(0)->flags();
-			tw->clear();
-
-			QString fileArg = "";
-			if (!propAddValue.isEmpty())
-				fileArg += "addValue=" + propAddValue + "@";
-			if (!propFileSep.isEmpty())
-				fileArg += "sep=" + propFileSep + "@";
-			fileArg += filePath;
-			GList list = listValuesFromFile(fileArg);
-			list.val = addColumnToListValues(list.val, list.addValue, columnCount);
-			for (int i = 0; i < list.val.count();) {
-				QStringList itemValues;
-				for (int j = 0; j < columnCount; ++j) {
-					itemValues << list.val.at(i++);
-					if (i == list.val.count())
-						break;
-				}
-				QTreeWidgetItem* item = new QTreeWidgetItem(tw, itemValues);
-				tw->addTopLevelItem(item);
-
-				flags |= item->flags();
-				item->setFlags(flags);
-				item->setTextAlignment(0, Qt::AlignLeft);
-
-				if (propSelectionType == "checklist") {
-					QCheckBox* cb = new QCheckBox();
-					cb->setContentsMargins(0, 0, 0, 0);
-					if (itemValues.at(0).toLower() == "true")
-						cb->setCheckState(Qt::Checked);
-					else
-						cb->setCheckState(Qt::Unchecked);
-					cb->setStyleSheet("QCheckBox::indicator {subcontrol-position: center center;}");
-					tw->setItemWidget(item, 0, cb);
-				} else if (propSelectionType == "radiolist") {
-					QRadioButton* rb = new QRadioButton();
-					rb->setContentsMargins(0, 0, 0, 0);
-					if (itemValues.at(0).toLower() == "true")
-						rb->setChecked(true);
-					else
-						rb->setChecked(false);
-					rb->setStyleSheet("QRadioButton::indicator {subcontrol-position: center center;}");
-					tw->setItemWidget(item, 0, rb);
-				}
-
-				if (!propSelectionType.isEmpty())
-					item->setText(0, QString());
-			}
+// End of "private slots"
 
-			for (int i = 0; i < columnCount; ++i) {
-				tw->resizeColumnToContents(i);
-			}
-		}
-	}
-}
+/******************************************************************************
+ * private (1 of 2): misc.
+ ******************************************************************************/
 
-void Guid::updateText(QString filePath) {
-	bool pathExists = pathTester(filePath);
-	if (!pathExists)
-		return;
-	QFileSystemWatcher* watcher = static_cast<QFileSystemWatcher*>(sender());
-	watcher->addPath(filePath);
-
-	foreach (QLabel* l, watcher->parent()->findChildren<QLabel*>()) {
-		for (int i = 1; i < 10; ++i) {
-			QString propMarkerFile = "guid_text_monitor_marker_file_" + QString::number(i);
-			if (l->property(propMarkerFile.toStdString().c_str()).toString() == filePath) {
-				setText(l);
-			}
-		}
+// --emit-changes: writes the ready events as far as stdout takes them. While a slow reader
+// holds back the output, changes keep coming to the ready list, which is formatted with
+// the latest values once the previous write is through.
+void Guid::writeFieldChanges() {
+	if (m_changeEvents.isEmpty() && !m_readyChanges.isEmpty()) {
+		const OutputFormat format = meta(m_dialog).outputFormat;
+		const QString dateFormat = meta(m_dialog).dateFormat;
+		const QString listRowSeparator = format == OutputFormat::Text ? meta(m_dialog).listRowSeparator : "\n";
+		QString events;
+		foreach (const QObject* field, m_readyChanges)
+			appendKeyedField(events, m_changeFields.value(field), format, dateFormat, listRowSeparator);
+		m_readyChanges.clear();
+		m_changeEvents = events.toUtf8();
 	}
-}
 
-void Guid::updateTextInfo(QString filePath) {
-	bool pathExists = pathTester(filePath);
-	if (!pathExists)
-		return;
-	QFileSystemWatcher* watcher = static_cast<QFileSystemWatcher*>(sender());
-	watcher->addPath(filePath);
+	const qint64 written = writeAvailableStdOut(m_changeEvents.constData(), m_changeEvents.size());
+	if (written < 0)
+		m_changeEvents.clear(); // nobody reads anymore
+	else
+		m_changeEvents.remove(0, int(written));
 
-	foreach (QTextEdit* ti, watcher->parent()->findChildren<QTextEdit*>()) {
-		if (ti->property("guid_text_filename").toString() == filePath && ti->property("guid_text_monitor_file").toBool()) {
-			setTextInfo(ti);
-		}
+#ifdef Q_OS_UNIX
+	if (!m_changeNotifier) {
+		m_changeNotifier = new QSocketNotifier(STDOUT_FILENO, QSocketNotifier::Write, this);
+		connect(m_changeNotifier, SIGNAL(activated(int)), SLOT(writeFieldChanges()));
 	}
+	m_changeNotifier->setEnabled(!m_changeEvents.isEmpty() || !m_readyChanges.isEmpty());
+#endif
 }
 
-// End of "private slots"
-
-/******************************************************************************
- * private (1 of 2): misc.
- ******************************************************************************/
-
 void Guid::createQRCode(QLabel* label, QString text, int size) {
 	qrcodegen::QrCode qrCode = qrcodegen::QrCode::encodeText(text.toUtf8().data(), qrcodegen::QrCode::Ecc::HIGH);
 	qint32 qrCodeSize = qrCode.getSize();
@@ -2190,6 +3914,63 @@ bool Guid::error(const QString message) {
 	return true;
 }
 
+void Guid::finishSession(int exitCode) {
+#ifdef Q_OS_UNIX
+	if (m_sessionFd < 0)
+		return;
+
+	uchar reply[4];
+	qToBigEndian<quint32>(exitCode, reply);
+	if (::write(m_sessionFd, reply, sizeof(reply)) < 0) {
+		// The client is gone; nothing left to report
+	}
+	m_sessionNotifier->setEnabled(false);
+	m_sessionNotifier->deleteLater();
+	m_sessionNotifier = NULL;
+	::close(m_sessionFd);
+	m_sessionFd = -1;
+
+	// Drop whatever the finished dialog still had pending
+	if (m_timeoutTimer)
+		m_timeoutTimer->stop();
+	if (m_changeTimer)
+		m_changeTimer->stop();
+	delete m_changeNotifier;
+	m_changeNotifier = NULL;
+	m_changeEvents.clear();
+	m_changeFields.clear();
+	m_changeTimes.clear();
+	m_readyChanges.clear();
+	QCoreApplication::removePostedEvents(this, QEvent::MetaCall);
+
+	if (gs_stdin) {
+		foreach (QSocketNotifier* notifier, gs_stdin->findChildren<QSocketNotifier*>())
+			notifier->setEnabled(false);
+		gs_stdin->disconnect(this);
+		gs_stdin->deleteLater();
+		gs_stdin = NULL;
+	}
+
+	if (m_dialog) {
+		m_dialog->disconnect(this);
+		m_dialog->hide();
+		m_dialog->deleteLater();
+		m_dialog = NULL;
+	}
+	m_sysTray = NULL; // child of the dialog
+
+	fflush(stdout);
+	fflush(stderr);
+	for (int i = 0; i < 3; ++i)
+		dup2(m_serverStdFds[i], i);
+	clearerr(stdin);
+
+	m_serverNotifier->setEnabled(true);
+#else
+	Q_UNUSED(exitCode)
+#endif
+}
+
 QString Guid::labelText(const QString& s) const {
 	// zenity uses pango markup, https://developer.gnome.org/pygtk/stable/pango-markup-language.html
 	// This near-html-subset isn't really compatible w/ Qt's html subset and we end up
@@ -2237,181 +4018,1104 @@ void Guid::listenToStdIn() {
 	}
 }
 
-void Guid::notify(const QString message, bool noClose) {
-	if (QDBusConnection::sessionBus().interface()->isServiceRegistered("org.freedesktop.Notifications")) {
-		QDBusInterface notifications("org.freedesktop.Notifications", "/org/freedesktop/Notifications", "org.freedesktop.Notifications");
-		const QString summary = (message.length() < 32) ? message : message.left(25) + "...";
-		QVariantMap hintMap;
-		QStringList hintList = m_notificationHints.split(':');
-		for (int i = 0; i < hintList.count() - 1; i += 2)
-			hintMap.insert(hintList.at(i), hintList.at(i + 1));
-		QDBusMessage msg = notifications.call("Notify", "Guid", m_notificationId, "dialog-information", summary, message,
-		    QStringList() /*actions*/, hintMap, m_timeout);
-		if (msg.arguments().count())
-			m_notificationId = msg.arguments().at(0).toUInt();
+void Guid::notify(const QString message, bool noClose) {
+	if (QDBusConnection::sessionBus().interface()->isServiceRegistered("org.freedesktop.Notifications")) {
+		QDBusInterface notifications("org.freedesktop.Notifications", "/org/freedesktop/Notifications", "org.freedesktop.Notifications");
+		const QString summary = (message.length() < 32) ? message : message.left(25) + "...";
+		QVariantMap hintMap;
+		QStringList hintList = m_notificationHints.split(':');
+		for (int i = 0; i < hintList.count() - 1; i += 2)
+			hintMap.insert(hintList.at(i), hintList.at(i + 1));
+		QDBusMessage msg = notifications.call("Notify", "Guid", m_notificationId, "dialog-information", summary, message,
+		    QStringList() /*actions*/, hintMap, m_timeout);
+		if (msg.arguments().count())
+			m_notificationId = msg.arguments().at(0).toUInt();
+		return;
+	}
+
+	QMessageBox* dlg = static_cast<QMessageBox*>(m_dialog);
+	if (!dlg) {
+		dlg = new QMessageBox;
+		dlg->setIcon(QMessageBox::Information);
+		dlg->setStandardButtons(noClose ? QMessageBox::NoButton : QMessageBox::Ok);
+		dlg->setWindowFlags(Qt::ToolTip);
+		dlg->setWindowOpacity(0.8);
+		if (QLabel* l = dlg->findChild<QLabel*>("qt_msgbox_label")) {
+			l->setWordWrap(true);
+			if (m_selectableLabel)
+				l->setTextInteractionFlags(l->textInteractionFlags() | Qt::TextSelectableByMouse);
+		}
+	}
+	dlg->setText(labelText(message));
+	SHOW_DIALOG
+	dlg->adjustSize();
+	dlg->move(QGuiApplication::screens().at(0)->availableGeometry().topRight() - QPoint(dlg->width() + 20, -20));
+}
+
+QString Guid::printForms() {
+	QOUT
+	// The rest of the last --emit-changes write, so that the output starts on its own line
+	if (!m_changeEvents.isEmpty())
+		writeAvailableStdOut(m_changeEvents.constData(), m_changeEvents.size(), true);
+	m_changeEvents.clear();
+
+	const QString dateFormat = meta(m_dialog).dateFormat;
+	const OutputFormat format = meta(m_dialog).outputFormat;
+
+	// A single pass over the output plan made with the form
+	QString result;
+	result.reserve(m_prefixOk.size() + m_outputPlan.count() * 16);
+	result += m_prefixOk;
+	if (format == OutputFormat::Text) {
+		const QString listRowSeparator = meta(m_dialog).listRowSeparator;
+		foreach (const OutputStep& step, m_outputPlan)
+			appendFormsValue(result, step, format, dateFormat, listRowSeparator);
+		qOut << result << Qt::endl;
+		return result;
+	}
+
+	// json: {"key": value, "tab or group": {...}}
+	// nul: key=value, each terminated by a NUL
+	// shell: key='value' lines
+	const QString listRowSeparator = "\n";
+	bool first = true;
+	if (format == OutputFormat::Json)
+		result += '{';
+	foreach (const OutputStep& step, m_outputPlan) {
+		if (format == OutputFormat::Json) {
+			if (step.kind == OutputStep::ObjectEnd) {
+				result += '}';
+				first = false;
+				continue;
+			}
+			if (!first)
+				result += ',';
+			appendOutputText(result, step.text, format);
+			result += ':';
+			first = step.kind == OutputStep::ObjectStart;
+			if (first)
+				result += '{';
+			else
+				appendFormsValue(result, step, format, dateFormat, listRowSeparator);
+		} else if (step.kind != OutputStep::ObjectStart && step.kind != OutputStep::ObjectEnd) {
+			appendKeyedField(result, step, format, dateFormat, listRowSeparator);
+		}
+	}
+	if (format == OutputFormat::Json) {
+		result += '}';
+		qOut << result << Qt::endl;
+	} else {
+		qOut << result << Qt::flush;
+	}
+	return result;
+}
+
+bool Guid::readGeneral(QStringList& args) {
+	QStringList remains;
+	for (int i = 0; i < args.count(); ++i) {
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Title) {
+			m_caption = NEXT_ARG;
+		} else if (option == Option::WindowIcon) {
+			m_icon = NEXT_ARG;
+		} else if (option == Option::Width) {
+			bool ok;
+			const int w = NEXT_ARG.toUInt(&ok);
+			if (!ok)
+				return !error("--width must be followed by a positive number");
+			m_size.setWidth(w);
+		} else if (option == Option::Height) {
+			bool ok;
+			const int h = NEXT_ARG.toUInt(&ok);
+			if (!ok)
+				return !error("--height must be followed by a positive number");
+			m_size.setHeight(h);
+		} else if (option == Option::Timeout) {
+			bool ok;
+			const int t = NEXT_ARG.toUInt(&ok);
+			if (!ok)
+				return !error("--timeout must be followed by a positive number");
+			if (!m_timeoutTimer) {
+				m_timeoutTimer = new QTimer(this);
+				m_timeoutTimer->setSingleShot(true);
+				connect(m_timeoutTimer, SIGNAL(timeout()), SLOT(quitDialog()));
+			}
+			m_timeoutTimer->start(t * 1000);
+		} else if (option == Option::PollInterval) {
+			bool ok;
+			const int ms = NEXT_ARG.toUInt(&ok);
+			if (!ok)
+				return !error("--poll-interval must be followed by a positive number");
+			m_pollInterval = ms;
+		} else if (option == Option::OkLabel) {
+			m_ok = NEXT_ARG;
+		} else if (option == Option::CancelLabel) {
+			m_cancel = NEXT_ARG;
+		} else if (option == Option::Modal) {
+			m_modal = true;
+		} else if (option == Option::AlwaysOnTop) {
+			m_alwaysOnTop = true;
+		} else if (option == Option::NoTaskbar) {
+			m_noTaskbar = true;
+		} else if (option == Option::Attach) {
+			bool ok;
+			const int w = NEXT_ARG.toUInt(&ok, 0);
+			if (!ok)
+				return !error("--attach must be followed by a positive number");
+			m_parentWindow = w;
+		} else if (option == Option::MaxJobs) {
+			bool ok;
+			const int n = NEXT_ARG.toUInt(&ok);
+			if (!ok)
+				return !error("--max-jobs must be followed by a positive number");
+			m_maxJobs = n;
+		} else if (option == Option::JobPolicy) {
+			const QString policy = NEXT_ARG;
+			if (policy == "queue")
+				m_jobPolicy = JobPolicy::Queue;
+			else if (policy == "drop")
+				m_jobPolicy = JobPolicy::Drop;
+			else if (policy == "replace")
+				m_jobPolicy = JobPolicy::Replace;
+			else
+				return !error("--job-policy must be followed by queue, drop or replace");
+		} else if (option == Option::JobTimeout) {
+			bool ok;
+			const int t = NEXT_ARG.toUInt(&ok);
+			if (!ok)
+				return !error("--job-timeout must be followed by a positive number");
+			m_jobTimeout = t;
+		} else if (option == Option::KillJobsOnExit) {
+			m_killJobsOnExit = true;
+		} else if (option == Option::Stats) {
+			m_stats = true;
+		} else if (option == Option::OutputPrefixOk) {
+			m_prefixOk = NEXT_ARG;
+		} else if (option == Option::OutputPrefixErr) {
+			m_prefixErr = NEXT_ARG;
+		} else {
+			remains << args.at(i);
+		}
+	}
+	args = remains;
+	return true;
+}
+
+void Guid::resetSession() {
+	if (m_timeoutTimer)
+		m_timeoutTimer->stop();
+	if (m_inputFlushTimer)
+		m_inputFlushTimer->stop();
+	if (m_changeTimer)
+		m_changeTimer->stop();
+	delete m_changeNotifier;
+	m_changeNotifier = NULL;
+	delete m_scrollAnimator;
+	m_scrollAnimator = NULL;
+	gs_markerSources.clear();
+
+	m_alwaysOnTop = false;
+	m_cachedText.clear();
+	m_cancel = QString();
+	m_caption = QString();
+	m_changeEvents.clear();
+	m_changeFields.clear();
+	m_changeInterval = -1;
+	m_changeTimes.clear();
+	m_closeToSysTray = false;
+	m_dialog = NULL;
+	m_helpMission = false;
+	m_icon = QString();
+	m_jobPolicy = JobPolicy::Queue;
+	m_jobStats = JobStats();
+	m_jobTimeout = 0;
+	m_killJobsOnExit = false;
+	m_maxJobs = 4;
+	m_modal = false;
+	m_noTaskbar = false;
+	m_notificationHints = QString();
+	m_notificationId = 0;
+	m_ok = QString();
+	m_okCommand = "";
+	m_okCommandToFooter = false;
+	m_okKeepOpen = false;
+	m_okValuesToFooter = false;
+	m_outputPlan.clear();
+	m_parentWindow = 0;
+	m_pendingInput.clear();
+	m_pendingJobs.clear();
+	m_pendingLabel = QString();
+	m_pendingValue = -1;
+	m_pollInterval = 0;
+	m_pollRunning = false; // its filesPolled() may have been dropped with the posted events
+	m_pollStamps.reset(); // a batch still running keeps the old one
+	m_prefixErr = "";
+	m_prefixOk = "";
+	m_progressStartTime = QDateTime();
+	m_readyChanges.clear();
+	m_selectableLabel = false;
+	m_size = QSize();
+	m_stats = false;
+	m_sysTray = NULL;
+	m_sysTrayMsg = false;
+	m_timeout = 0;
+	m_type = Invalid;
+}
+
+void Guid::run(QStringList argList) {
+	m_zenity = argList.at(0).endsWith("zenity");
+	// make canonical list
+	QStringList args;
+	if (argList.at(0).endsWith("-askpass")) {
+		argList.removeFirst();
+		args << "--title" << tr("Enter Password") << "--password" << "--prompt" << argList.join(' ');
+	} else {
+		for (int i = 1; i < argList.count(); ++i) {
+			if (argList.at(i).startsWith("--")) {
+				int split = argList.at(i).indexOf('=');
+				if (split > -1) {
+					args << argList.at(i).left(split) << argList.at(i).mid(split + 1);
+				} else {
+					args << argList.at(i);
+				}
+			} else {
+				args << argList.at(i);
+			}
+		}
+	}
+	argList.clear();
+
+	// --form-cache: reuse what an earlier launch with the same arguments read from disk
+	QString formCacheEntry;
+	const int formCacheIndex = args.indexOf("--form-cache");
+	if (formCacheIndex > -1) {
+		const QString formCacheDir = args.value(formCacheIndex + 1);
+		args = args.mid(0, formCacheIndex) + args.mid(formCacheIndex + 2);
+		bool specFromStdIn = false; // its content is not part of the key
+		for (int i = args.indexOf("--forms-spec"); i > -1; i = args.indexOf("--forms-spec", i + 1))
+			specFromStdIn = specFromStdIn || args.value(i + 1) == "-";
+		if (!formCacheDir.isEmpty() && !specFromStdIn) {
+			formCacheEntry = formCacheEntryPath(formCacheDir, args);
+			gs_formCache = new FormCache;
+			if (loadFormCache(formCacheEntry, *gs_formCache))
+				args = gs_formCache->args;
+			else
+				*gs_formCache = FormCache();
+		}
+	}
+
+	// The options described by a spec file take the place of --forms-spec
+	for (int i = args.indexOf("--forms-spec"); i > -1; i = args.indexOf("--forms-spec", i)) {
+		QStringList specArgs;
+		QString specError;
+		if (!readFormsSpec(args.value(i + 1), specArgs, specError)) {
+			finishFormCache(formCacheEntry, false);
+			error("--forms-spec: " + specError);
+			return;
+		}
+		if (!args.contains("--forms") && !specArgs.contains("--forms"))
+			specArgs.prepend("--forms");
+		args = args.mid(0, i) + specArgs + args.mid(i + 2);
+		i += specArgs.count();
+	}
+	if (gs_formCache && !gs_formCache->loaded)
+		gs_formCache->args = args;
+
+	if (!readGeneral(args)) {
+		finishFormCache(formCacheEntry, false);
+		return;
+	}
+
+	char error = 1;
+	foreach (const QString& arg, args) {
+		if (arg == "--calendar") {
+			m_type = Calendar;
+			error = showCalendar(args);
+		} else if (arg == "--entry") {
+			m_type = Entry;
+			error = showEntry(args);
+		} else if (arg == "--error") {
+			m_type = Error;
+			error = showMessage(args, 'e');
+		} else if (arg == "--info") {
+			m_type = Info;
+			error = showMessage(args, 'i');
+		} else if (arg == "--file-selection") {
+			m_type = FileSelection;
+			error = showFileSelection(args);
+		} else if (arg == "--list") {
+			m_type = List;
+			error = showList(args);
+		} else if (arg == "--notification") {
+			m_type = Notification;
+			error = showNotification(args);
+		} else if (arg == "--progress") {
+			m_type = Progress;
+			error = showProgress(args);
+		} else if (arg == "--multi-progress") {
+			m_type = MultiProgress;
+			error = showMultiProgress(args);
+		} else if (arg == "--question") {
+			m_type = Question;
+			error = showMessage(args, 'q');
+		} else if (arg == "--warning") {
+			m_type = Warning;
+			error = showMessage(args, 'w');
+		} else if (arg == "--scale") {
+			m_type = Scale;
+			error = showScale(args);
+		} else if (arg == "--text-info") {
+			m_type = TextInfo;
+			error = showText(args);
+		} else if (arg == "--color-selection") {
+			m_type = ColorSelection;
+			error = showColorSelection(args);
+		} else if (arg == "--font-selection") {
+			m_type = FontSelection;
+			error = showFontSelection(args);
+		} else if (arg == "--password") {
+			m_type = Password;
+			error = showPassword(args);
+		} else if (arg == "--forms") {
+			m_type = Forms;
+			error = showForms(args);
+		}
+		if (error != 1) {
+			break;
+		}
+	}
+	finishFormCache(formCacheEntry, !error);
+
+	if (error) {
+		QMetaObject::invokeMethod(this, "exitGuid", Qt::QueuedConnection, Q_ARG(int, 2));
+		return;
+	}
+
+	if (m_dialog) {
+		// close on ctrl+return in addition to ctrl+enter
+		QAction* shortAccept = new QAction(m_dialog);
+		m_dialog->addAction(shortAccept);
+		shortAccept->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_Return));
+		connect(shortAccept, SIGNAL(triggered()), m_dialog, SLOT(accept()));
+
+		// workaround for #21 - since QWidget is now merely bitrot, QDialog closes,
+		// but does not reject on the escape key (unlike announced in the specific section of the API)
+		QAction* shortReject = new QAction(m_dialog);
+		m_dialog->addAction(shortReject);
+		shortReject->setShortcut(QKeySequence(Qt::Key_Escape));
+		connect(shortReject, SIGNAL(triggered()), m_dialog, SLOT(reject()));
+
+		m_dialog->setWindowModality(m_modal ? Qt::ApplicationModal : Qt::NonModal);
+		if (!m_caption.isNull())
+			m_dialog->setWindowTitle(m_caption);
+		if (!m_icon.isNull())
+			m_dialog->setWindowIcon(QIcon(m_icon));
+		QDialogButtonBox* box = m_dialog->findChild<QDialogButtonBox*>();
+		if (box && !m_ok.isNull()) {
+			if (QPushButton* btn = box->button(QDialogButtonBox::Ok))
+				btn->setText(m_ok);
+		}
+		if (box && !m_cancel.isNull()) {
+			if (QPushButton* btn = box->button(QDialogButtonBox::Cancel))
+				btn->setText(m_cancel);
+		}
+		if (m_parentWindow) {
+#ifdef WS_X11
+			m_dialog->setAttribute(Qt::WA_X11BypassTransientForHint);
+			XSetTransientForHint(QX11Info::display(), m_dialog->winId(), m_parentWindow);
+#endif
+		}
+	}
+}
+
+void Guid::setSysTrayAction(QString actionId, bool valueToSet) {
+	QSystemTrayIcon* sysTrayIcon = static_cast<QSystemTrayIcon*>(m_sysTray);
+	if (sysTrayIcon) {
+		QList<QAction*> actions = sysTrayIcon->contextMenu()->actions();
+		foreach (QAction* action, actions) {
+			if (meta(action).sysTrayMenuAction == actionId) {
+				action->setEnabled(valueToSet);
+				break;
+			}
+		}
+	}
+}
+
+bool Guid::startServer(const QString& socketPath) {
+#ifdef Q_OS_UNIX
+	const QByteArray path = serverSocketPath(socketPath);
+	struct sockaddr_un addr;
+	if (!setSocketAddress(&addr, path))
+		return !error("invalid server socket path: " + QFile::decodeName(path));
+
+	int fd = connectToServer(path);
+	if (fd > -1) {
+		::close(fd);
+		return !error("a guid server is already listening on " + QFile::decodeName(path));
+	}
+
+	fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0)
+		return !error("cannot create the server socket");
+	fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+	// A stale socket left by a server that was killed is removed, but nothing else
+	struct stat pathStat;
+	if (::lstat(path.constData(), &pathStat) == 0) {
+		if (!S_ISSOCK(pathStat.st_mode)) {
+			::close(fd);
+			return !error(QFile::decodeName(path) + " exists and is not a socket");
+		}
+		::unlink(path.constData());
+	}
+
+	// Created private: no other user may connect between bind() and listen()
+	const mode_t oldUmask = umask(0077);
+	const bool bound = ::bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == 0;
+	umask(oldUmask);
+	if (!bound || ::listen(fd, 16) < 0) {
+		::close(fd);
+		return !error("cannot listen on " + QFile::decodeName(path));
+	}
+
+	// Keep our own standard streams to restore them after each session
+	for (int i = 0; i < 3; ++i)
+		m_serverStdFds[i] = fcntl(i, F_DUPFD_CLOEXEC, 3);
+
+	// stdin is swapped under stdio's feet, so it must not buffer ahead
+	setvbuf(stdin, NULL, _IONBF, 0);
+	signal(SIGPIPE, SIG_IGN);
+	setQuitOnLastWindowClosed(false);
+
+	m_serverFd = fd;
+	m_serverNotifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+	connect(m_serverNotifier, SIGNAL(activated(int)), SLOT(serverAccept()));
+
+	return true;
+#else
+	Q_UNUSED(socketPath)
+	return !error("--server is only supported on Unix-like systems");
+#endif
+}
+
+// Entries sent with --control are shown whatever the OK button settings
+void Guid::updateFooterContent(QGroupBox* footer, QString newEntry, bool fromControl) {
+	if (!footer || !(m_okCommandToFooter || m_okValuesToFooter || fromControl))
+		return;
+
+	QFormLayout* footerLayout = static_cast<QFormLayout*>(footer->layout());
+	if (!footerLayout)
+		return;
+
+	int nbEntriesToDisplay = meta(footer).footerNbEntries;
+	int footerHeight = footer->height();
+	footer->setVisible(true);
+
+	QLabel* newLabel = new QLabel();
+	newLabel->setText(newEntry);
+	newLabel->setWordWrap(true);
+	newLabel->setTextInteractionFlags(newLabel->textInteractionFlags() | Qt::TextSelectableByMouse);
+
+	footerLayout->insertRow(0, newLabel);
+
+	int nbEntries = 0;
+	for (int i = 0; i < footerLayout->count(); ++i) {
+		nbEntries++;
+		if (nbEntries <= nbEntriesToDisplay)
+			continue;
+		footerLayout->removeRow(nbEntries - 1);
+	}
+
+	int newFooterHeight = footer->height();
+	if (newFooterHeight > footerHeight) {
+		QFileDialog* dialog = static_cast<QFileDialog*>(m_dialog);
+		if (dialog) {
+			QSize dialogSize = dialog->size();
+			dialogSize.setHeight(newFooterHeight - footerHeight);
+			dialog->resize(dialogSize);
+		}
+	}
+}
+
+void Guid::updateFooterContentFromFile(QGroupBox* footer, QString filePath) {
+	if (!QFile::exists(filePath))
+		return;
+
+	if (meta(footer).follow) {
+		// Only the appended lines are new entries, the last one on top
+		bool restarted;
+		QByteArray content = readFollowedFile(footer, filePath, restarted);
+		if (content.isEmpty())
+			return;
+		QStringList newEntries = splitValues(content.constData(), content.size(), "\n");
+		int nbEntriesToDisplay = meta(footer).footerNbEntries;
+		for (int i = qMax(0, newEntries.count() - nbEntriesToDisplay); i < newEntries.count(); ++i) {
+			updateFooterContent(footer, newEntries.at(i));
+		}
+
+		return;
+	}
+
+	QStringList newEntries;
+	QFile file(filePath);
+	if (file.open(QIODevice::ReadOnly)) {
+		QByteArray content = file.readAll();
+		newEntries = splitValues(content.constData(), content.size(), "\n");
+		file.close();
+	}
+
+	int nbNewEntries = newEntries.count();
+	for (int i = nbNewEntries - 1; i >= 0; --i) {
+		updateFooterContent(footer, newEntries.at(i));
+	}
+}
+
+void Guid::parseFile(QWidget* widget, const QString& filePath, const QString& fileSep) {
+	// A newer generation makes the parse still queued or running for the widget give up
+	QSharedPointer<QAtomicInt>& latest = m_parseGenerations[widget];
+	if (!latest)
+		latest.reset(new QAtomicInt(0));
+	int generation = latest->fetchAndAddOrdered(1) + 1;
+	const FileSignature* signature = qobject_cast<QTreeWidget*>(widget) ? &meta(widget).listSignature : NULL;
+	QThreadPool::globalInstance()->start(new FileParser(this, widget, filePath, fileSep, latest, generation, signature));
+}
+
+// Applies the --control=stdin commands read at once, one JSON object per line. The form
+// is repainted once for the whole batch.
+void Guid::runControlCommands(const QByteArray& input) {
+	QOUT_ERR
+	if (!m_dialog)
+		return;
+
+	QHash<QString, QWidget*> fields;
+	foreach (QWidget* w, m_dialog->findChildren<QWidget*>()) {
+		const QString var = meta(w).var;
+		if (!var.isEmpty() && !fields.contains(var))
+			fields.insert(var, w);
+	}
+	const QString dateFormat = meta(m_dialog).dateFormat;
+	QSet<QTreeWidget*> changedLists;
+
+	m_dialog->setUpdatesEnabled(false);
+	foreach (const QByteArray& line, input.split('\n')) {
+		if (line.trimmed().isEmpty())
+			continue;
+
+		QJsonParseError parseError;
+		const QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+		if (!document.isObject()) {
+			qOutErr << m_prefixErr + "--control: " + (parseError.error != QJsonParseError::NoError ? parseError.errorString() : QString("expected an object")) << Qt::endl;
+			continue;
+		}
+		const QJsonObject command = document.object();
+		const QString name = command.value("cmd").toString();
+		const QString var = command.value("var").toString();
+
+		if (name == "footer") {
+			QGroupBox* footer = m_dialog->findChild<QGroupBox*>("dialogFooter");
+			foreach (const QJsonValue& entry, command.value("entries").toArray())
+				updateFooterContent(footer, controlText(entry), true); // the last one on top
+			continue;
+		}
+
+		QWidget* w = fields.value(var);
+		if (!w) {
+			qOutErr << m_prefixErr + "--control: unknown variable \"" + var + "\"" << Qt::endl;
+			continue;
+		}
+		QTreeWidget* tw = qobject_cast<QTreeWidget*>(w);
+		QLabel* text = qobject_cast<QLabel*>(w);
+
+		if (name == "set" && !text && !tw) {
+			if (!setFormsWidgetValue(w, command.value("value"), dateFormat))
+				qOutErr << m_prefixErr + "--control: invalid value for \"" + var + "\"" << Qt::endl;
+		} else if (name == "add-rows" && tw) {
+			// A short row is padded, as addItems() takes the cells of all the rows in a row
+			const int columnCount = qMax(tw->columnCount(), 1);
+			QStringList values;
+			foreach (const QJsonValue& row, command.value("rows").toArray()) {
+				QStringList itemValues;
+				if (row.isArray()) {
+					foreach (const QJsonValue& cell, row.toArray())
+						itemValues << controlText(cell);
+				} else {
+					itemValues << controlText(row);
+				}
+				while (itemValues.count() < columnCount)
+					itemValues << QString();
+				values << itemValues.mid(0, columnCount);
+			}
+			const int oldCount = tw->topLevelItemCount();
+			const int twflags = meta(tw).listFlags;
+			addItems(tw, values, twflags & 1, twflags & 1 << 1, twflags & 1 << 2);
+			uncheckOtherRadioRows(tw, oldCount);
+			changedLists << tw;
+		} else if (name == "remove-rows" && tw) {
+			if (command.value("all").toBool()) {
+				tw->clear();
+			} else {
+				QList<int> rows;
+				foreach (const QJsonValue& row, command.value("rows").toArray())
+					rows << row.toInt(-1);
+				std::sort(rows.begin(), rows.end(), std::greater<int>());
+				rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+				foreach (int row, rows) {
+					if (row > -1 && row < tw->topLevelItemCount())
+						delete tw->takeTopLevelItem(row);
+				}
+			}
+			changedLists << tw;
+		} else if (name == "marker" && text) {
+			editMeta(text).textMarkerValues.insert(command.value("marker").toInt(1), controlText(command.value("value")));
+			setText(text);
+		} else if (name == "enable" || name == "disable") {
+			// The whole field, with its button or value label, but not the other field of
+			// its columns
+			QWidget* parent = w->parentWidget();
+			const WidgetMeta::Container container = parent ? meta(parent).container : WidgetMeta::NoContainer;
+			if (container != WidgetMeta::NoContainer && container != WidgetMeta::ColumnsContainer)
+				w = parent;
+			w->setEnabled(name == "enable");
+		} else {
+			qOutErr << m_prefixErr + "--control: unsupported command \"" + name + "\" for \"" + var + "\"" << Qt::endl;
+		}
+	}
+
+	foreach (QTreeWidget* tw, changedLists) {
+		for (int i = 0; i < tw->columnCount(); ++i)
+			tw->resizeColumnToContents(i);
+	}
+	m_dialog->setUpdatesEnabled(true);
+}
+
+void Guid::startInputFlush() {
+	if (!m_inputFlushTimer) {
+		m_inputFlushTimer = new QTimer(this);
+		m_inputFlushTimer->setSingleShot(true);
+		m_inputFlushTimer->setInterval(16);
+		connect(m_inputFlushTimer, SIGNAL(timeout()), SLOT(flushInput()));
+	}
+	if (!m_inputFlushTimer->isActive())
+		m_inputFlushTimer->start();
+}
+
+void Guid::updateCombo(QComboBox* combo, const QStringList& values) {
+	if (!meta(combo).monitorFile)
+		return;
+
+	combo->clear();
+	combo->addItems(values);
+	int currentIndex = meta(combo).comboDefaultIndex;
+	if (currentIndex > 0 && currentIndex < combo->count()) {
+		combo->setCurrentIndex(currentIndex);
+	}
+}
+
+void Guid::updateList(QTreeWidget* tw, const QStringList& values) {
+	bool propMonitorFile = meta(tw).monitorFile;
+	QString propSelectionType = meta(tw).listSelectionType;
+	QString propAddValue = meta(tw).listAddValue;
+
+	if (!propMonitorFile)
+		return;
+
+	int columnCount = tw->columnCount();
+	Qt::ItemFlags flags = tw->topLevelItemCount() ? tw->topLevelItem(0)->flags() : QTreeWidgetItem().flags();
+
+	GList list = GList();
+	list.val = addColumnToListValues(values, propAddValue, columnCount);
+
+	QList<QStringList> rows;
+	for (int i = 0; i < list.val.count();) {
+		QStringList itemValues;
+		for (int j = 0; j < columnCount; ++j) {
+			itemValues << list.val.at(i++);
+			if (i == list.val.count())
+				break;
+		}
+		rows << itemValues;
+	}
+
+	// With a check/radio list, the first column holds the initial state: it is not
+	// compared, so that the state set by the user is kept
+	const int firstColumn = propSelectionType.isEmpty() ? 0 : 1;
+	auto sameRow = [&](QTreeWidgetItem* item, const QStringList& itemValues) {
+		for (int j = firstColumn; j < columnCount; ++j) {
+			if (item->text(j) != itemValues.value(j))
+				return false;
+		}
+		return true;
+	};
+
+	// Only the rows between the common head and the common tail are updated
+	const int oldCount = tw->topLevelItemCount();
+	const int newCount = rows.count();
+	int head = 0;
+	while (head < oldCount && head < newCount && sameRow(tw->topLevelItem(head), rows.at(head)))
+		++head;
+	int tail = 0;
+	while (tail < oldCount - head && tail < newCount - head &&
+	    sameRow(tw->topLevelItem(oldCount - 1 - tail), rows.at(newCount - 1 - tail)))
+		++tail;
+
+	if (head == oldCount && head == newCount)
+		return;
+
+	// Modified rows
+	const int oldEnd = oldCount - tail;
+	const int newEnd = newCount - tail;
+	int i = head;
+	for (; i < oldEnd && i < newEnd; ++i) {
+		QTreeWidgetItem* item = tw->topLevelItem(i);
+		for (int j = firstColumn; j < columnCount; ++j)
+			item->setText(j, rows.at(i).value(j));
+	}
+
+	// Removed rows
+	for (int k = oldEnd - 1; k >= i; --k)
+		delete tw->takeTopLevelItem(k);
+
+	// Inserted rows
+	for (; i < newEnd; ++i) {
+		const QStringList& itemValues = rows.at(i);
+		QTreeWidgetItem* item = new QTreeWidgetItem(itemValues);
+		tw->insertTopLevelItem(i, item);
+
+		flags |= item->flags();
+		item->setFlags(flags);
+		item->setTextAlignment(0, Qt::AlignLeft);
+
+		if (!propSelectionType.isEmpty())
+			item->setCheckState(0, itemValues.at(0).toLower() == "true" ? Qt::Checked : Qt::Unchecked);
+
+		if (!propSelectionType.isEmpty())
+			item->setText(0, QString());
+	}
+
+	for (int i = 0; i < columnCount; ++i) {
+		tw->resizeColumnToContents(i);
+	}
+}
+
+void Guid::updateListRows() {
+	QTreeWidget* tw = m_dialog->findChild<QTreeWidget*>();
+	if (!tw)
 		return;
-	}
 
-	QMessageBox* dlg = static_cast<QMessageBox*>(m_dialog);
-	if (!dlg) {
-		dlg = new QMessageBox;
-		dlg->setIcon(QMessageBox::Information);
-		dlg->setStandardButtons(noClose ? QMessageBox::NoButton : QMessageBox::Ok);
-		dlg->setWindowFlags(Qt::ToolTip);
-		dlg->setWindowOpacity(0.8);
-		if (QLabel* l = dlg->findChild<QLabel*>("qt_msgbox_label")) {
-			l->setWordWrap(true);
-			if (m_selectableLabel)
-				l->setTextInteractionFlags(l->textInteractionFlags() | Qt::TextSelectableByMouse);
-		}
+	// Each complete line is a row with its first cell set, as when the lines were added one
+	// by one: the batch is padded for addItems(), which fills the columns of a row in turn
+	const int end = m_pendingInput.lastIndexOf('\n');
+	if (end < 0)
+		return;
+
+	const int columnCount = qMax(tw->columnCount(), 1);
+	QStringList values;
+	foreach (const QString& line, QString::fromLocal8Bit(m_pendingInput.constData(), end).split('\n')) {
+		values << line;
+		for (int i = 1; i < columnCount; ++i)
+			values << QString();
 	}
-	dlg->setText(labelText(message));
-	SHOW_DIALOG
-	dlg->adjustSize();
-	dlg->move(QGuiApplication::screens().at(0)->availableGeometry().topRight() - QPoint(dlg->width() + 20, -20));
+	m_pendingInput.remove(0, end + 1);
+
+	const int oldCount = tw->topLevelItemCount();
+	const int twflags = meta(tw).listFlags;
+	addItems(tw, values, twflags & 1, twflags & 1 << 1, twflags & 1 << 2);
+	uncheckOtherRadioRows(tw, oldCount);
 }
 
-QString Guid::printForms() {
-	QOUT QFileDialog* dialog = static_cast<QFileDialog*>(m_dialog);
-	QList<QFormLayout*> layouts = dialog->findChildren<QFormLayout*>();
-	// We skip the first layout used for the top menu.
-	QFormLayout* fl = layouts.at(1);
-	QStringList resultList;
-	ValuePair resultPair;
-	QString dateFormat = dialog->property("guid_date_format").toString();
-	QString separator = dialog->property("guid_separator").toString();
-	QString listRowSeparator = dialog->property("guid_list_row_separator").toString();
-	for (int i = 0; i < fl->count(); ++i) {
-		if (QLayoutItem* li = fl->itemAt(i, QFormLayout::FieldRole)) {
-			resultPair = getFormsWidgetValue(li->widget(), dateFormat, separator, listRowSeparator);
-			if (resultPair.first)
-				resultList << resultPair.second;
+void Guid::updateMultiProgress() {
+	QTreeWidget* tw = m_dialog->findChild<QTreeWidget*>();
+	if (!tw)
+		return;
+
+	// Rows are created as their jobs first appear, and then found by job
+	const qint64 now = QDateTime::currentMSecsSinceEpoch();
+	QHash<QString, QTreeWidgetItem*>& rows = editMeta(tw).progressRows;
+	foreach (const ProgressUpdate& update, m_pendingJobs) {
+		QTreeWidgetItem*& item = rows[update.job];
+		if (!item) {
+			item = new QTreeWidgetItem(tw, QStringList() << update.job);
+			item->setData(0, Qt::UserRole, now);
+			item->setData(2, Qt::DisplayRole, 0);
+		}
+		if (!update.label.isNull())
+			item->setText(1, update.label);
+		if (update.value < 0)
+			continue;
+
+		item->setData(2, Qt::DisplayRole, update.value);
+		const qint64 secs = (now - item->data(0, Qt::UserRole).toLongLong()) / 1000;
+		if (update.value == 100) {
+			item->setText(3, QString());
+			item->setText(4, QString());
+		} else if (secs > 0 && update.value > 0) {
+			item->setText(3, QString::number(double(update.value) / secs, 'f', 1) + tr(" %/s"));
+			item->setText(4, QTime(0, 0, 0).addSecs(100 * secs / update.value - secs).toString());
 		}
 	}
-	QString result = m_prefixOk + resultList.join(separator);
-	qOut << result << Qt::endl;
-	return result;
-}
+	m_pendingJobs.clear();
 
-bool Guid::readGeneral(QStringList& args) {
-	QStringList remains;
-	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--title") {
-			m_caption = NEXT_ARG;
-		} else if (args.at(i) == "--window-icon") {
-			m_icon = NEXT_ARG;
-		} else if (args.at(i) == "--width") {
-			bool ok;
-			const int w = NEXT_ARG.toUInt(&ok);
-			if (!ok)
-				return !error("--width must be followed by a positive number");
-			m_size.setWidth(w);
-		} else if (args.at(i) == "--height") {
-			bool ok;
-			const int h = NEXT_ARG.toUInt(&ok);
-			if (!ok)
-				return !error("--height must be followed by a positive number");
-			m_size.setHeight(h);
-		} else if (args.at(i) == "--timeout") {
-			bool ok;
-			const int t = NEXT_ARG.toUInt(&ok);
-			if (!ok)
-				return !error("--timeout must be followed by a positive number");
-			QTimer::singleShot(t * 1000, this, SLOT(quitDialog()));
-		} else if (args.at(i) == "--ok-label") {
-			m_ok = NEXT_ARG;
-		} else if (args.at(i) == "--cancel-label") {
-			m_cancel = NEXT_ARG;
-		} else if (args.at(i) == "--modal") {
-			m_modal = true;
-		} else if (args.at(i) == "--always-on-top") {
-			m_alwaysOnTop = true;
-		} else if (args.at(i) == "--no-taskbar") {
-			m_noTaskbar = true;
-		} else if (args.at(i) == "--attach") {
-			bool ok;
-			const int w = NEXT_ARG.toUInt(&ok, 0);
-			if (!ok)
-				return !error("--attach must be followed by a positive number");
-			m_parentWindow = w;
-		} else if (args.at(i) == "--output-prefix-ok") {
-			m_prefixOk = NEXT_ARG;
-		} else if (args.at(i) == "--output-prefix-err") {
-			m_prefixErr = NEXT_ARG;
-		} else {
-			remains << args.at(i);
-		}
+	if (gs_stdin && gs_stdin->isOpen())
+		return;
+
+	// End of the input
+	if (meta(m_dialog).autoClose) {
+		QTimer::singleShot(250, this, SLOT(quitDialog()));
+	} else if (QDialogButtonBox* btns = m_dialog->findChild<QDialogButtonBox*>()) {
+		btns->setStandardButtons(QDialogButtonBox::Ok);
+		if (!m_ok.isNull())
+			btns->button(QDialogButtonBox::Ok)->setText(m_ok);
 	}
-	args = remains;
-	return true;
 }
 
-void Guid::setSysTrayAction(QString actionId, bool valueToSet) {
-	QSystemTrayIcon* sysTrayIcon = static_cast<QSystemTrayIcon*>(m_sysTray);
-	if (sysTrayIcon) {
-		QList<QAction*> actions = sysTrayIcon->contextMenu()->actions();
-		foreach (QAction* action, actions) {
-			if (action->property("guid_systray_menu_action").toString() == actionId) {
-				action->setEnabled(valueToSet);
-				break;
-			}
+void Guid::updateProgress() {
+	QProgressDialog* dlg = static_cast<QProgressDialog*>(m_dialog);
+
+	const int oldValue = dlg->value();
+	if (!m_pendingLabel.isNull()) {
+		dlg->setLabelText(labelText(m_pendingLabel));
+		m_pendingLabel = QString();
+	}
+	if (m_pendingValue > -1) {
+		dlg->setValue(m_pendingValue);
+		m_pendingValue = -1;
+	}
+
+	if (dlg->maximum() == 0)
+		return; // we just need the label support
+
+	if (dlg->value() == 100) {
+		finishProgress();
+	} else if (oldValue == 100) {
+		disconnect(dlg, SIGNAL(canceled()), dlg, SLOT(accept()));
+		connect(dlg, SIGNAL(canceled()), dlg, SLOT(reject()));
+		dlg->setCancelButtonText(m_cancel.isNull() ? tr("Cancel") : m_cancel);
+	} else if (meta(dlg).eta) {
+		if (m_progressStartTime.isNull()) {
+			m_progressStartTime = QDateTime::currentDateTime();
+		} else if (dlg->value() > 0) {
+			const qint64 secs = m_progressStartTime.secsTo(QDateTime::currentDateTime());
+			QString eta = QTime(0, 0, 0).addSecs(100 * secs / dlg->value() - secs).toString();
+			foreach (QWidget* w, dlg->findChildren<QWidget*>())
+				w->setToolTip(eta);
 		}
 	}
 }
 
-void Guid::updateFooterContent(QGroupBox* footer, QString newEntry) {
-	if (!footer || !(m_okCommandToFooter || m_okValuesToFooter))
+void Guid::updateTextInfo() {
+	QTextEdit* te = m_dialog->findChild<QTextEdit*>();
+	if (!te || m_cachedText.isEmpty())
 		return;
 
-	QFormLayout* footerLayout = static_cast<QFormLayout*>(footer->layout());
-	if (!footerLayout)
+	// A tag or a character entity split between two reads would be inserted as text: an
+	// unterminated one at the end of the HTML waits for more input
+	int length = m_cachedText.length();
+	if (meta(te).html && gs_stdin && gs_stdin->isOpen()) {
+		const int tag = m_cachedText.lastIndexOf('<');
+		if (tag > m_cachedText.lastIndexOf('>'))
+			length = tag;
+		int entity = length - 1;
+		while (entity > -1 && (m_cachedText.at(entity).isLetterOrNumber() || m_cachedText.at(entity) == '#'))
+			--entity;
+		if (entity > -1 && m_cachedText.at(entity) == '&')
+			length = entity;
+	}
+	if (!length)
 		return;
 
-	int nbEntriesToDisplay = footer->property("guid_footer_nb_entries").toInt();
-	int footerHeight = footer->height();
-	footer->setVisible(true);
+	// Appended at the end of the document: the cost does not grow with what is already shown
+	QScrollBar* scrollBar = te->verticalScrollBar();
+	const int oldValue = scrollBar ? scrollBar->value() : 0;
+	QTextCursor cursor(te->document());
+	cursor.movePosition(QTextCursor::End);
+	if (meta(te).html)
+		cursor.insertHtml(m_cachedText.left(length));
+	else
+		cursor.insertText(m_cachedText);
+	m_cachedText.remove(0, length);
+
+	if (scrollBar && meta(te).autoScroll) {
+		if (!m_scrollAnimator) {
+			m_scrollAnimator = new QPropertyAnimation(scrollBar, "value", this);
+			m_scrollAnimator->setEasingCurve(QEasingCurve::InOutCubic);
+		}
+		// A running animation is given the new end instead of being restarted
+		const int diff = scrollBar->maximum() - oldValue;
+		if (m_scrollAnimator->state() == QPropertyAnimation::Running) {
+			m_scrollAnimator->setEndValue(scrollBar->maximum());
+		} else if (diff > 0) {
+			m_scrollAnimator->setDuration(qMin(qMax(200, diff), 2500));
+			m_scrollAnimator->setEndValue(scrollBar->maximum());
+			m_scrollAnimator->start();
+		}
+	}
+}
 
-	QLabel* newLabel = new QLabel();
-	newLabel->setText(newEntry);
-	newLabel->setWordWrap(true);
-	newLabel->setTextInteractionFlags(newLabel->textInteractionFlags() | Qt::TextSelectableByMouse);
+void Guid::watchFile(const QString& filePath, QWidget* widget, FileWatchKind kind, int pollInterval) {
+	if (!m_fileWatcher) {
+		m_fileWatcher = new QFileSystemWatcher(this);
+		connect(m_fileWatcher, SIGNAL(directoryChanged(QString)), SLOT(directoryChanged(QString)));
+		connect(m_fileWatcher, SIGNAL(fileChanged(QString)), SLOT(fileChanged(QString)));
 
-	footerLayout->insertRow(0, newLabel);
+		m_fileDispatchTimer = new QTimer(this);
+		m_fileDispatchTimer->setSingleShot(true);
+		m_fileDispatchTimer->setInterval(50);
+		connect(m_fileDispatchTimer, SIGNAL(timeout()), SLOT(dispatchFileChanges()));
+	}
 
-	int nbEntries = 0;
-	for (int i = 0; i < footerLayout->count(); ++i) {
-		nbEntries++;
-		if (nbEntries <= nbEntriesToDisplay)
-			continue;
-		footerLayout->removeRow(nbEntries - 1);
+	QList<FileSubscriber>& subscribers = m_fileSubscribers[filePath];
+	const FileSubscriber subscriber(widget, kind);
+	if (subscribers.contains(subscriber))
+		return;
+	if (subscribers.isEmpty()) {
+		m_fileWatcher->addPath(filePath);
+
+		// The directory is watched too, to notice the file being replaced by another one
+		const QString dirPath = QFileInfo(filePath).absolutePath();
+		QStringList& dirFiles = m_watchedDirs[dirPath];
+		if (dirFiles.isEmpty())
+			m_fileWatcher->addPath(dirPath);
+		dirFiles << filePath;
+	}
+	subscribers << subscriber;
+
+	// inotify does not see the changes made by another host of a network filesystem
+	if (pollInterval <= 0)
+		pollInterval = m_pollInterval;
+	if (pollInterval > 0) {
+		pollInterval = qMax(pollInterval, 100);
+		QPair<int, qint64>& polledFile = m_polledFiles[filePath];
+		if (polledFile.first <= 0 || pollInterval < polledFile.first)
+			polledFile = qMakePair(pollInterval, QDateTime::currentMSecsSinceEpoch() + pollInterval);
+
+		if (!m_pollTimer) {
+			m_pollTimer = new QTimer(this);
+			connect(m_pollTimer, SIGNAL(timeout()), SLOT(pollFiles()));
+		}
+		if (!m_pollTimer->isActive() || pollInterval < m_pollTimer->interval())
+			m_pollTimer->start(pollInterval);
 	}
 
-	int newFooterHeight = footer->height();
-	if (newFooterHeight > footerHeight) {
-		QFileDialog* dialog = static_cast<QFileDialog*>(m_dialog);
-		if (dialog) {
-			QSize dialogSize = dialog->size();
-			dialogSize.setHeight(newFooterHeight - footerHeight);
-			dialog->resize(dialogSize);
-		}
+	QStringList& watchedFiles = m_watchedFiles[widget];
+	if (watchedFiles.isEmpty())
+		connect(widget, SIGNAL(destroyed(QObject*)), SLOT(unwatchFiles(QObject*)));
+	watchedFiles << filePath;
+}
+
+void Guid::finishJob(QProcess* process) {
+	if (!m_runningJobs.contains(process))
+		return; // already finished: FailedToStart then finished
+	const Job job = m_runningJobs.take(process);
+	const qint64 run = m_jobClock.elapsed() - job.started;
+	m_jobStats.finished++;
+	m_jobStats.runTotal += run;
+	m_jobStats.runMax = qMax(m_jobStats.runMax, run);
+
+	if (job.output == Job::FooterOutput) {
+		if (job.footer)
+			updateFooterContent(job.footer, QString::fromLocal8Bit(process->readAllStandardOutput()).trimmed());
+	} else if (job.output == Job::MenuOutput) {
+		QOUT
+		qOut << QString::fromLocal8Bit(process->readAllStandardOutput()) << "|MENU_CLICKED_DATA_END";
 	}
+	process->deleteLater();
+
+	while (!m_jobQueue.isEmpty() && (m_maxJobs == 0 || m_runningJobs.count() < m_maxJobs))
+		runJob(m_jobQueue.takeFirst());
 }
 
-void Guid::updateFooterContentFromFile(QGroupBox* footer, QString filePath) {
-	if (!QFile::exists(filePath))
+// Runs the job, or applies --job-policy when --max-jobs are already running
+void Guid::queueJob(Job job) {
+	if (!m_jobClock.isValid())
+		m_jobClock.start();
+	job.queued = m_jobClock.elapsed();
+	if (m_maxJobs == 0 || m_runningJobs.count() < m_maxJobs) {
+		runJob(job);
 		return;
+	}
 
-	QStringList newEntries;
-	QFile file(filePath);
-	QTextCodec::setCodecForLocale(QTextCodec::codecForName("UTF-8"));
-	if (file.open(QIODevice::ReadOnly)) {
-		newEntries = QString::fromLocal8Bit(file.readAll()).trimmed().replace(QRegExp("[\r\n]+"), "\n").split("\n");
-		file.close();
+	switch (m_jobPolicy) {
+	case JobPolicy::Drop:
+		m_jobStats.dropped++;
+		return;
+	case JobPolicy::Replace:
+		m_jobStats.replaced += m_jobQueue.count();
+		m_jobQueue.clear();
+		break;
+	case JobPolicy::Queue:
+		break;
 	}
+	m_jobQueue << job;
+	m_jobStats.maxQueued = qMax(m_jobStats.maxQueued, m_jobQueue.count());
+}
 
-	int nbNewEntries = newEntries.count();
-	for (int i = nbNewEntries - 1; i >= 0; --i) {
-		updateFooterContent(footer, newEntries.at(i));
+void Guid::runJob(Job job) {
+	job.started = m_jobClock.elapsed();
+	const qint64 wait = job.started - job.queued;
+	m_jobStats.started++;
+	m_jobStats.waitTotal += wait;
+	m_jobStats.waitMax = qMax(m_jobStats.waitMax, wait);
+
+	// Not a child of the application: without --kill-jobs-on-exit, a job outlives the dialog
+	QProcess* process = new QProcess;
+	if (job.output == Job::NoOutput)
+		process->setProcessChannelMode(QProcess::ForwardedChannels);
+	connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, [=]() {
+		finishJob(process);
+	});
+	connect(process, &QProcess::errorOccurred, this, [=](QProcess::ProcessError error) {
+		if (error == QProcess::FailedToStart)
+			finishJob(process);
+	});
+	if (m_jobTimeout > 0) {
+		QTimer::singleShot(m_jobTimeout * 1000, process, [=]() {
+			m_jobStats.timedOut++;
+			process->kill();
+		});
+	}
+	m_runningJobs.insert(process, job);
+	process->start(job.program, job.args);
+	process->closeWriteChannel();
+}
+
+// Called on exit: kills the jobs with --kill-jobs-on-exit, or lets them run, and prints
+// --stats. The jobs whose output goes to the dialog are killed anyway: their output pipe
+// is about to lose its reader.
+void Guid::stopJobs() {
+	QHash<QProcess*, Job>::const_iterator it;
+	for (it = m_runningJobs.constBegin(); it != m_runningJobs.constEnd(); ++it) {
+		QProcess* process = it.key();
+		disconnect(process, NULL, this, NULL);
+		if (m_killJobsOnExit || it.value().output != Job::NoOutput) {
+			m_jobStats.killed++;
+			process->kill();
+			process->waitForFinished(100);
+			process->deleteLater();
+		} else {
+			connect(process, SIGNAL(finished(int, QProcess::ExitStatus)), process, SLOT(deleteLater()));
+		}
+	}
+	m_runningJobs.clear();
+
+	// Queued jobs whose output nobody is left to show are started anyway, as they were
+	// when each command was started detached
+	foreach (const Job& job, m_jobQueue) {
+		if (m_killJobsOnExit || job.output != Job::NoOutput)
+			m_jobStats.dropped++;
+		else if (QProcess::startDetached(job.program, job.args))
+			m_jobStats.started++;
+	}
+	m_jobQueue.clear();
+
+	if (m_stats) {
+		QOUT_ERR
+		const JobStats& st = m_jobStats;
+		qOutErr << m_prefixErr + "jobs: started=" << st.started << " finished=" << st.finished
+		        << " dropped=" << st.dropped << " replaced=" << st.replaced << " timed-out=" << st.timedOut
+		        << " killed=" << st.killed << " max-queued=" << st.maxQueued
+		        << " wait-avg-ms=" << (st.started ? st.waitTotal / st.started : 0) << " wait-max-ms=" << st.waitMax
+		        << " run-avg-ms=" << (st.finished ? st.runTotal / st.finished : 0) << " run-max-ms=" << st.runMax
+		        << Qt::endl;
 	}
 }
 
@@ -2431,10 +5135,11 @@ char Guid::showCalendar(const QStringList& args) {
 	QLabel* label = new QLabel("");
 	bool ok;
 	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--text") {
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Text) {
 			label = new QLabel(NEXT_ARG, dlg);
 			tll->addWidget(label);
-		} else if (args.at(i) == "--align") {
+		} else if (option == Option::Align) {
 			if (label) {
 				QString alignment = NEXT_ARG;
 				if (alignment == "left")
@@ -2447,20 +5152,20 @@ char Guid::showCalendar(const QStringList& args) {
 					qOutErr << m_prefixErr + "argument --align: unknown value" << args.at(i) << Qt::endl;
 			} else
 				WARN_UNKNOWN_ARG("--text");
-		} else if (args.at(i) == "--day") {
+		} else if (option == Option::Day) {
 			d = NEXT_ARG.toUInt(&ok);
 			if (!ok)
 				return !error("--day must be followed by a positive number");
-		} else if (args.at(i) == "--month") {
+		} else if (option == Option::Month) {
 			m = NEXT_ARG.toUInt(&ok);
 			if (!ok)
 				return !error("--month must be followed by a positive number");
-		} else if (args.at(i) == "--year") {
+		} else if (option == Option::Year) {
 			y = NEXT_ARG.toUInt(&ok);
 			if (!ok)
 				return !error("--year must be followed by a positive number");
-		} else if (args.at(i) == "--date-format") {
-			dlg->setProperty("guid_date_format", NEXT_ARG);
+		} else if (option == Option::DateFormat) {
+			editMeta(dlg).dateFormat = NEXT_ARG;
 		} else {
 			WARN_UNKNOWN_ARG("--calendar")
 		}
@@ -2488,12 +5193,13 @@ char Guid::showColorSelection(const QStringList& args) {
 	for (int i = 0; i < l.count() && i < dlg->customCount(); ++i)
 		dlg->setCustomColor(i, QColor(l.at(i).toUInt()));
 	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--color") {
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Color) {
 			dlg->setCurrentColor(QColor(NEXT_ARG));
-		} else if (args.at(i) == "--show-palette") {
+		} else if (option == Option::ShowPalette) {
 			qOutErr << m_prefixErr + "The show-palette parameter is not supported by guid. Sorry." << Qt::endl;
 			void(0);
-		} else if (args.at(i) == "--custom-palette") {
+		} else if (option == Option::CustomPalette) {
 			if (i + 1 < args.count()) {
 				QString path = NEXT_ARG;
 				QFile file(path);
@@ -2540,20 +5246,21 @@ char Guid::showColorSelection(const QStringList& args) {
 char Guid::showEntry(const QStringList& args) {
 	QInputDialog* dlg = new QInputDialog;
 	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--text")
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Text)
 			dlg->setLabelText(labelText(NEXT_ARG));
-		else if (args.at(i) == "--entry-text")
+		else if (option == Option::EntryText)
 			dlg->setTextValue(NEXT_ARG);
-		else if (args.at(i) == "--hide-text")
+		else if (option == Option::HideText)
 			dlg->setTextEchoMode(QLineEdit::Password);
-		else if (args.at(i) == "--values") {
+		else if (option == Option::Values) {
 			dlg->setComboBoxItems(NEXT_ARG.split('|'));
 			dlg->setComboBoxEditable(true);
-		} else if (args.at(i) == "--int") {
+		} else if (option == Option::Int) {
 			dlg->setInputMode(QInputDialog::IntInput);
 			dlg->setIntRange(INT_MIN, INT_MAX);
 			dlg->setIntValue(NEXT_ARG.toInt());
-		} else if (args.at(i) == "--float") {
+		} else if (option == Option::Float) {
 			dlg->setInputMode(QInputDialog::DoubleInput);
 			dlg->setDoubleRange(DBL_MIN, DBL_MAX);
 			dlg->setDoubleValue(NEXT_ARG.toDouble());
@@ -2572,7 +5279,7 @@ char Guid::showFileSelection(const QStringList& args) {
 	dlg->setViewMode(settings.value("FileDetails", false).toBool() ? QFileDialog::Detail : QFileDialog::List);
 	dlg->setFileMode(QFileDialog::ExistingFile);
 	dlg->setOption(QFileDialog::DontConfirmOverwrite, false);
-	dlg->setProperty("guid_separator", "|");
+	editMeta(dlg).separator = "|";
 	QVariantList l = settings.value("Bookmarks").toList();
 	QList<QUrl> bookmarks;
 	for (int i = 0; i < l.count(); ++i)
@@ -2581,25 +5288,26 @@ char Guid::showFileSelection(const QStringList& args) {
 		dlg->setSidebarUrls(bookmarks);
 	QStringList mimeFilters;
 	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--filename") {
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Filename) {
 			QString path = NEXT_ARG;
 			if (path.endsWith("/."))
 				dlg->setDirectory(path);
 			else
 				dlg->selectFile(path);
-		} else if (args.at(i) == "--multiple")
+		} else if (option == Option::Multiple)
 			dlg->setFileMode(QFileDialog::ExistingFiles);
-		else if (args.at(i) == "--directory") {
+		else if (option == Option::Directory) {
 			dlg->setFileMode(QFileDialog::Directory);
 			dlg->setOption(QFileDialog::ShowDirsOnly);
-		} else if (args.at(i) == "--save") {
+		} else if (option == Option::Save) {
 			dlg->setFileMode(QFileDialog::AnyFile);
 			dlg->setAcceptMode(QFileDialog::AcceptSave);
-		} else if (args.at(i) == "--separator")
-			dlg->setProperty("guid_separator", NEXT_ARG);
-		else if (args.at(i) == "--confirm-overwrite")
+		} else if (option == Option::Separator)
+			editMeta(dlg).separator = NEXT_ARG;
+		else if (option == Option::ConfirmOverwrite)
 			dlg->setOption(QFileDialog::DontConfirmOverwrite);
-		else if (args.at(i) == "--file-filter") {
+		else if (option == Option::FileFilter) {
 			QString mimeFilter = NEXT_ARG;
 			const int idx = mimeFilter.indexOf('|');
 			if (idx > -1)
@@ -2620,7 +5328,8 @@ char Guid::showFontSelection(const QStringList& args) {
 	QString pattern = "%1-%2:%3:%4";
 	QString sample = "The quick brown fox jumps over the lazy dog.";
 	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--type") {
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Type) {
 			QStringList types = NEXT_ARG.split(',');
 			QFontDialog::FontDialogOptions opts;
 			for (const QString& type : types) {
@@ -2636,18 +5345,18 @@ char Guid::showFontSelection(const QStringList& args) {
 			if (opts) // https://bugreports.qt.io/browse/QTBUG-93473
 				dlg->setOptions(opts);
 			dlg->setCurrentFont(QFont()); // also works around the bug :P
-		} else if (args.at(i) == "--pattern") {
+		} else if (option == Option::Pattern) {
 			pattern = NEXT_ARG;
 			if (!pattern.contains("%1"))
 				qOutErr << m_prefixErr + "The output pattern doesn't include a placeholder for the font name..." << Qt::endl;
-		} else if (args.at(i) == "--sample") {
+		} else if (option == Option::Sample) {
 			sample = NEXT_ARG;
 		}
 		{ WARN_UNKNOWN_ARG("--font-selection") }
 	}
 	if (QLineEdit* smpl = dlg->findChild<QLineEdit*>("qt_fontDialog_sampleEdit"))
 		smpl->setText(sample);
-	dlg->setProperty("guid_fontpattern", pattern);
+	editMeta(dlg).fontPattern = pattern;
 	SHOW_DIALOG
 	return 0;
 }
@@ -2662,8 +5371,8 @@ char Guid::showForms(const QStringList& args) {
 
 	NEW_DIALOG // *dlg, *tll
 
-	    dlg->setProperty("guid_separator", "|");
-	dlg->setProperty("guid_list_row_separator", "~");
+	    editMeta(dlg).separator = "|";
+	editMeta(dlg).listRowSeparator = "~";
 
 	Qt::WindowFlags dlgFlags = Qt::WindowCloseButtonHint;
 	dlg->setWindowFlags(dlgFlags);
@@ -2706,7 +5415,6 @@ char Guid::showForms(const QStringList& args) {
 	QWidget* header = new QWidget();
 	header->setVisible(false);
 	header->setContentsMargins(0, 0, 0, 0);
-	header->setProperty("guid_header_container", true);
 
 	QFormLayout* headerLayout = new QFormLayout();
 	headerLayout->setContentsMargins(wSpacing, wSpacing, wSpacing, wSpacing);
@@ -2735,12 +5443,9 @@ char Guid::showForms(const QStringList& args) {
 
 	QGroupBox* footer = new QGroupBox(tr("Recent activity"));
 	footer->setObjectName("dialogFooter");
-	footer->setProperty("guid_footer_nb_entries", 3);
-	footer->setProperty("guid_footer_file_path", "");
-	footer->setProperty("guid_footer_monitor_file", false);
+	editMeta(footer).footerNbEntries = 3;
 	footer->setVisible(false);
 
-	QFileSystemWatcher* footerWatcher = new QFileSystemWatcher(dlg);
 
 	QFormLayout* footerLayout = new QFormLayout();
 	footerLayout->setContentsMargins(wSpacing, wSpacing, wSpacing, wSpacing);
@@ -2768,7 +5473,7 @@ char Guid::showForms(const QStringList& args) {
      **************************************/
 
 	QTabWidget* lastTabBar = new QTabWidget();
-	lastTabBar->setProperty("guid_tab_bar_verbose", false);
+	editMeta(lastTabBar).tabBarVerbose = false;
 	lastTabBar->setStyleSheet(QTABBAR_STYLE);
 
 	QLabel* lastTabBarLabel = NULL;
@@ -2816,7 +5521,6 @@ char Guid::showForms(const QStringList& args) {
 	QComboBox* lastCombo = NULL;
 	QLabel* lastComboLabel = NULL;
 	GList lastComboGList = GList();
-	QFileSystemWatcher* comboWatcher = new QFileSystemWatcher(dlg);
 
 	// entry
 	QLineEdit* lastEntry = NULL;
@@ -2846,7 +5550,6 @@ char Guid::showForms(const QStringList& args) {
 	Qt::ItemFlags lastListFlags;
 	int lastListHeight = -1;
 	QStringList lastListColumns;
-	QFileSystemWatcher* listWatcher = new QFileSystemWatcher(dlg);
 
 	// menu
 	QMenuBar* lastMenu = NULL;
@@ -2881,7 +5584,6 @@ char Guid::showForms(const QStringList& args) {
 	// text
 	QLabel* lastText = NULL;
 	QLabel* lastTextLabel = NULL;
-	QFileSystemWatcher* textWatcher = new QFileSystemWatcher(dlg);
 
 	// text-info || text-browser
 
@@ -2890,7 +5592,6 @@ char Guid::showForms(const QStringList& args) {
 	QTextBrowser* lastTextBrowser = NULL;
 	QLabel* lastTextBrowserLabel = NULL;
 
-	QFileSystemWatcher* textInfoWatcher = new QFileSystemWatcher(dlg);
 
 	// vspacer
 	QLabel* lastVSpacer = NULL;
@@ -2902,18 +5603,17 @@ char Guid::showForms(const QStringList& args) {
      **************************************/
 
 	QString next_arg;
-	QStringList next_arg_split;
-	QStringList next_arg_join;
 	WidgetSettings ws;
 	bool ok;
 
 	for (int i = 0; i < args.count(); ++i) {
+		const Option option = optionFromArg(args.at(i));
 		/********************************************************************************
          * WIDGET CONTAINERS
          ********************************************************************************/
 
 		// --header
-		if (args.at(i) == "--header") {
+		if (option == Option::Header) {
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
 
@@ -2942,12 +5642,12 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --group
-		else if (args.at(i) == "--group") {
+		else if (option == Option::Group) {
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
 
 			if (!lastWidgetVar.isEmpty() && lastWidget) {
-				lastWidget->setProperty("guid_var", lastWidgetVar);
+				editMeta(lastWidget).var = lastWidgetVar;
 			}
 
 			if (ws.stop) {
@@ -2971,9 +5671,9 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --tab
-		else if (args.at(i) == "--tab") {
+		else if (option == Option::Tab) {
 			if (!lastWidgetVar.isEmpty() && lastWidget) {
-				lastWidget->setProperty("guid_var", lastWidgetVar);
+				editMeta(lastWidget).var = lastWidgetVar;
 			}
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -2997,10 +5697,10 @@ char Guid::showForms(const QStringList& args) {
 				lastTabLayout = new QFormLayout();
 
 				lastTab->setLayout(lastTabLayout);
-				lastTab->setProperty("guid_tab_disable_buttons", ws.disableButtons);
+				editMeta(lastTab).tabDisableButtons = ws.disableButtons;
 
 				if (ws.verboseTabBar)
-					lastTabBar->setProperty("guid_tab_bar_verbose", ws.verboseTabBar);
+					editMeta(lastTabBar).tabBarVerbose = ws.verboseTabBar;
 
 				int indexTab = lastTabBar->addTab(lastTab, lastTabName);
 				if (ws.selected) {
@@ -3014,9 +5714,9 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --col1
-		else if (args.at(i) == "--col1") {
+		else if (option == Option::Col1) {
 			if (!lastWidgetVar.isEmpty() && lastWidget) {
-				lastWidget->setProperty("guid_var", lastWidgetVar);
+				editMeta(lastWidget).var = lastWidgetVar;
 			}
 			lastColumn = "col1";
 			columnsLayout = new QHBoxLayout();
@@ -3024,9 +5724,9 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --col2
-		else if (args.at(i) == "--col2") {
+		else if (option == Option::Col2) {
 			if (!lastWidgetVar.isEmpty() && lastWidget) {
-				lastWidget->setProperty("guid_var", lastWidgetVar);
+				editMeta(lastWidget).var = lastWidgetVar;
 			}
 			lastColumn = "col2";
 			lastWidgetVar.clear();
@@ -3037,7 +5737,7 @@ char Guid::showForms(const QStringList& args) {
          ********************************************************************************/
 
 		// QCalendarWidget: --add-calendar
-		else if (args.at(i) == "--add-calendar") {
+		else if (option == Option::AddCalendar) {
 			SWITCH_FORM_WIDGET("calendar")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3046,13 +5746,13 @@ char Guid::showForms(const QStringList& args) {
 			lastWidget = lastCalendar;
 			lastCalendarLabel = new QLabel(next_arg);
 
-			lastCalendar->setProperty("guid_hide", false);
+			editMeta(lastCalendar).hide = false;
 
 			ADD_WIDGET_TO_FORM(lastCalendarLabel, lastCalendar)
 		}
 
 		// QCheckBox: --add-checkbox
-		else if (args.at(i) == "--add-checkbox") {
+		else if (option == Option::AddCheckbox) {
 			SWITCH_FORM_WIDGET("checkbox")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3061,8 +5761,8 @@ char Guid::showForms(const QStringList& args) {
 			lastWidget = lastCheckbox;
 			lastCheckboxLabel = new QLabel(ws.addLabel);
 
-			lastCheckbox->setProperty("guid_checkbox_default", "unchecked");
-			lastCheckbox->setProperty("guid_hide", false);
+			editMeta(lastCheckbox).checkboxDefault = false;
+			editMeta(lastCheckbox).hide = false;
 
 			if (ws.addLabel.isEmpty())
 				ws.hideLabel = true;
@@ -3071,7 +5771,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// QLineEdit: --add-entry
-		else if (args.at(i) == "--add-entry") {
+		else if (option == Option::AddEntry) {
 			SWITCH_FORM_WIDGET("entry")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3080,18 +5780,18 @@ char Guid::showForms(const QStringList& args) {
 			lastWidget = lastEntry;
 			lastEntryLabel = new QLabel(next_arg);
 
-			lastEntry->setProperty("guid_hide", false);
+			editMeta(lastEntry).hide = false;
 
 			ADD_WIDGET_TO_FORM(lastEntryLabel, lastEntry)
 		}
 
 		// QFileDialog: --add-file-selection
-		else if (args.at(i) == "--add-file-selection") {
+		else if (option == Option::AddFileSelection) {
 			SWITCH_FORM_WIDGET("file-sel")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
 
-			lastFileSel = new QFileDialog();
+			lastFileSel = new QFileDialog(dlg);
 			lastFileSelLabel = new QLabel(next_arg);
 
 			QString lastFileSelButtonText = tr("Select");
@@ -3110,7 +5810,7 @@ char Guid::showForms(const QStringList& args) {
 			lastFileSelLayout->addWidget(lastFileSelEntry);
 
 			lastFileSelContainer = new QWidget();
-			lastFileSelContainer->setProperty("guid_file_sel_container", true);
+			editMeta(lastFileSelContainer).container = WidgetMeta::FileSelContainer;
 			lastFileSelContainer->setLayout(lastFileSelLayout);
 
 			lastFileSel->setViewMode(
@@ -3121,10 +5821,9 @@ char Guid::showForms(const QStringList& args) {
 			lastFileSel->setOption(QFileDialog::DontUseNativeDialog);
 			lastFileSel->setFilter(
 			    QDir::AllDirs | QDir::AllEntries | QDir::Hidden | QDir::System);
-			lastFileSel->setProperty(
-			    "guid_file_sel_separator",
-			    dlg->property("guid_separator").toString());
-			lastFileSel->setProperty("guid_hide", false);
+			const QString fileSelSeparator = meta(dlg).separator;
+			editMeta(lastFileSel).fileSelSeparator = fileSelSeparator;
+			editMeta(lastFileSel).hide = false;
 
 			QVariantList guidBookmarksList = guidQSsettings.value("Bookmarks").toList();
 			QList<QUrl> lastFileSelBookmarks;
@@ -3139,7 +5838,7 @@ char Guid::showForms(const QStringList& args) {
 				    if (lastFileSel->exec()) {
 					    QStringList files = lastFileSel->selectedFiles();
 					    QString text = files.join(
-					        lastFileSel->property("guid_file_sel_separator").toString());
+					        meta(lastFileSel).fileSelSeparator);
 					    lastFileSelEntry->setText(text);
 				    }
 			    });
@@ -3148,7 +5847,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// QMenuBar: --add-menu
-		else if (args.at(i) == "--add-menu") {
+		else if (option == Option::AddMenu) {
 			if (lastWidgetId.isEmpty() && lastColumn.isEmpty()) {
 				lastMenuIsTopMenu = true;
 				formsSettings.hasTopMenu = true;
@@ -3164,7 +5863,7 @@ char Guid::showForms(const QStringList& args) {
 			lastWidget = lastMenu;
 			lastMenuLabel = new QLabel(ws.addLabel);
 
-			lastMenu->setProperty("guid_hide", false);
+			editMeta(lastMenu).hide = false;
 
 			if (lastMenuIsTopMenu)
 				lastMenu->setStyleSheet("background: white; border-top: 1px solid #F0F0F0;");
@@ -3238,10 +5937,11 @@ char Guid::showForms(const QStringList& args) {
 						if (menuItemIcon != "false" || menuItemIcon != "0")
 							menuAction->setIcon(menuActionIcon);
 
-						menuAction->setProperty("guid_menu_item_name", menuItemName);
-						menuAction->setProperty("guid_menu_item_exit_code", menuItemExitCode);
-						menuAction->setProperty("guid_menu_item_command", menuItemCommand);
-						menuAction->setProperty("guid_menu_item_command_print_output", menuItemCommandPrintOutput);
+						WidgetMeta& actionMeta = editMeta(menuAction);
+						actionMeta.menuItemName = menuItemName;
+						actionMeta.menuItemExitCode = menuItemExitCode;
+						actionMeta.menuItemCommand = menuItemCommand;
+						actionMeta.menuItemCommandPrintOutput = menuItemCommandPrintOutput;
 
 						menuItem->addAction(menuAction);
 
@@ -3254,10 +5954,11 @@ char Guid::showForms(const QStringList& args) {
 				// Menu without submenu items (first level elements are added as QAction)
 				else {
 					QAction* menuAction = new QAction(menuItemName, this);
-					menuAction->setProperty("guid_menu_item_name", menuItemName);
-					menuAction->setProperty("guid_menu_item_exit_code", menuItemExitCode);
-					menuAction->setProperty("guid_menu_item_command", menuItemCommand);
-					menuAction->setProperty("guid_menu_item_command_print_output", menuItemCommandPrintOutput);
+					WidgetMeta& actionMeta = editMeta(menuAction);
+					actionMeta.menuItemName = menuItemName;
+					actionMeta.menuItemExitCode = menuItemExitCode;
+					actionMeta.menuItemCommand = menuItemCommand;
+					actionMeta.menuItemCommandPrintOutput = menuItemCommandPrintOutput;
 
 					lastMenu->addAction(menuAction);
 
@@ -3269,7 +5970,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// QLineEdit: --add-password
-		else if (args.at(i) == "--add-password") {
+		else if (option == Option::AddPassword) {
 			SWITCH_FORM_WIDGET("password")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3279,13 +5980,13 @@ char Guid::showForms(const QStringList& args) {
 			lastPasswordLabel = new QLabel(next_arg);
 
 			lastPassword->setEchoMode(QLineEdit::Password);
-			lastPassword->setProperty("guid_hide", false);
+			editMeta(lastPassword).hide = false;
 
 			ADD_WIDGET_TO_FORM(lastPasswordLabel, lastPassword)
 		}
 
 		// QSpinBox: --add-spin-box
-		else if (args.at(i) == "--add-spin-box") {
+		else if (option == Option::AddSpinBox) {
 			SWITCH_FORM_WIDGET("spin-box")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3294,14 +5995,14 @@ char Guid::showForms(const QStringList& args) {
 			lastWidget = lastSpinBox;
 			lastSpinBoxLabel = new QLabel(next_arg);
 
-			lastSpinBox->setProperty("guid_hide", false);
-			lastSpinBox->setProperty("guid_spin_box_default", INT_MIN);
+			editMeta(lastSpinBox).hide = false;
+			editMeta(lastSpinBox).spinBoxDefault = INT_MIN;
 
 			ADD_WIDGET_TO_FORM(lastSpinBoxLabel, lastSpinBox)
 		}
 
 		// QDoubleSpinBox: --add-double-spin-box
-		else if (args.at(i) == "--add-double-spin-box") {
+		else if (option == Option::AddDoubleSpinBox) {
 			SWITCH_FORM_WIDGET("double-spin-box")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3314,14 +6015,14 @@ char Guid::showForms(const QStringList& args) {
 			dv_locale.setNumberOptions(QLocale::RejectGroupSeparator);
 			lastDoubleSpinBox->setLocale(dv_locale);
 
-			lastDoubleSpinBox->setProperty("guid_hide", false);
-			lastDoubleSpinBox->setProperty("guid_double_spin_box_default", -DBL_MAX);
+			editMeta(lastDoubleSpinBox).hide = false;
+			editMeta(lastDoubleSpinBox).doubleSpinBoxDefault = -DBL_MAX;
 
 			ADD_WIDGET_TO_FORM(lastDoubleSpinBoxLabel, lastDoubleSpinBox)
 		}
 
 		// QLabel: --add-text
-		else if (args.at(i) == "--add-text") {
+		else if (option == Option::AddText) {
 			SWITCH_FORM_WIDGET("text")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3330,40 +6031,10 @@ char Guid::showForms(const QStringList& args) {
 			lastWidget = lastText;
 			lastTextLabel = new QLabel(ws.addLabel);
 
-			lastText->setProperty("guid_hide", false);
-			lastText->setProperty("guid_text_content", "");
-
-			lastText->setProperty("guid_text_monitor_marker_file_1", "");
-			lastText->setProperty("guid_text_monitor_marker_file_2", "");
-			lastText->setProperty("guid_text_monitor_marker_file_3", "");
-			lastText->setProperty("guid_text_monitor_marker_file_4", "");
-			lastText->setProperty("guid_text_monitor_marker_file_5", "");
-			lastText->setProperty("guid_text_monitor_marker_file_6", "");
-			lastText->setProperty("guid_text_monitor_marker_file_7", "");
-			lastText->setProperty("guid_text_monitor_marker_file_8", "");
-			lastText->setProperty("guid_text_monitor_marker_file_9", "");
-
-			lastText->setProperty("guid_text_monitor_var_name_1", "");
-			lastText->setProperty("guid_text_monitor_var_name_2", "");
-			lastText->setProperty("guid_text_monitor_var_name_3", "");
-			lastText->setProperty("guid_text_monitor_var_name_4", "");
-			lastText->setProperty("guid_text_monitor_var_name_5", "");
-			lastText->setProperty("guid_text_monitor_var_name_6", "");
-			lastText->setProperty("guid_text_monitor_var_name_7", "");
-			lastText->setProperty("guid_text_monitor_var_name_8", "");
-			lastText->setProperty("guid_text_monitor_var_name_9", "");
-
-			lastText->setProperty("guid_text_def_marker_val_1", "");
-			lastText->setProperty("guid_text_def_marker_val_2", "");
-			lastText->setProperty("guid_text_def_marker_val_3", "");
-			lastText->setProperty("guid_text_def_marker_val_4", "");
-			lastText->setProperty("guid_text_def_marker_val_5", "");
-			lastText->setProperty("guid_text_def_marker_val_6", "");
-			lastText->setProperty("guid_text_def_marker_val_7", "");
-			lastText->setProperty("guid_text_def_marker_val_8", "");
-			lastText->setProperty("guid_text_def_marker_val_9", "");
-
-			lastText->setProperty("guid_text_markers_set", false);
+			editMeta(lastText).hide = false;
+			editMeta(lastText).textContent = "";
+
+			editMeta(lastText).textMarkersSet = false;
 
 			lastText->setContentsMargins(0, 3, 0, 0);
 			lastText->setTextInteractionFlags(lastText->textInteractionFlags() | Qt::TextSelectableByMouse);
@@ -3381,136 +6052,20 @@ char Guid::showForms(const QStringList& args) {
 				                 "</tr></table>";
 			}
 			lastText->setText(lastTextContent);
+			editMeta(lastText).textContent = lastTextContent; // for --control markers
 
-			if (!ws.monitorMarkerFile1.isEmpty() || !ws.monitorMarkerFile2.isEmpty() || !ws.monitorMarkerFile3.isEmpty() || !ws.monitorMarkerFile4.isEmpty() || !ws.monitorMarkerFile5.isEmpty() || !ws.monitorMarkerFile6.isEmpty() || !ws.monitorMarkerFile7.isEmpty() || !ws.monitorMarkerFile8.isEmpty() || !ws.monitorMarkerFile9.isEmpty()) {
-				lastText->setProperty("guid_text_content", lastTextContent);
-
-				if (!ws.monitorMarkerFile1.isEmpty()) {
-					lastText->setProperty("guid_text_monitor_marker_file_1", ws.monitorMarkerFile1);
-					if (QFile::exists(ws.monitorMarkerFile1)) {
-						textWatcher->addPath(ws.monitorMarkerFile1);
-						connect(textWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateText(QString)), Qt::UniqueConnection);
-					}
-
-					if (!ws.monitorVarName1.isEmpty())
-						lastText->setProperty("guid_text_monitor_var_name_1", ws.monitorVarName1);
-
-					if (!ws.defMarkerVal1.isEmpty())
-						lastText->setProperty("guid_text_def_marker_val_1", ws.defMarkerVal1);
-				}
-
-				if (!ws.monitorMarkerFile2.isEmpty()) {
-					lastText->setProperty("guid_text_monitor_marker_file_2", ws.monitorMarkerFile2);
-					if (QFile::exists(ws.monitorMarkerFile2)) {
-						textWatcher->addPath(ws.monitorMarkerFile2);
-						connect(textWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateText(QString)), Qt::UniqueConnection);
-					}
-
-					if (!ws.monitorVarName2.isEmpty())
-						lastText->setProperty("guid_text_monitor_var_name_2", ws.monitorVarName2);
-
-					if (!ws.defMarkerVal2.isEmpty())
-						lastText->setProperty("guid_text_def_marker_val_2", ws.defMarkerVal2);
-				}
-
-				if (!ws.monitorMarkerFile3.isEmpty()) {
-					lastText->setProperty("guid_text_monitor_marker_file_3", ws.monitorMarkerFile3);
-					if (QFile::exists(ws.monitorMarkerFile3)) {
-						textWatcher->addPath(ws.monitorMarkerFile3);
-						connect(textWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateText(QString)), Qt::UniqueConnection);
-					}
-
-					if (!ws.monitorVarName3.isEmpty())
-						lastText->setProperty("guid_text_monitor_var_name_3", ws.monitorVarName3);
-
-					if (!ws.defMarkerVal3.isEmpty())
-						lastText->setProperty("guid_text_def_marker_val_3", ws.defMarkerVal3);
-				}
-
-				if (!ws.monitorMarkerFile4.isEmpty()) {
-					lastText->setProperty("guid_text_monitor_marker_file_4", ws.monitorMarkerFile4);
-					if (QFile::exists(ws.monitorMarkerFile4)) {
-						textWatcher->addPath(ws.monitorMarkerFile4);
-						connect(textWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateText(QString)), Qt::UniqueConnection);
-					}
-
-					if (!ws.monitorVarName4.isEmpty())
-						lastText->setProperty("guid_text_monitor_var_name_4", ws.monitorVarName4);
-
-					if (!ws.defMarkerVal4.isEmpty())
-						lastText->setProperty("guid_text_def_marker_val_4", ws.defMarkerVal4);
-				}
-
-				if (!ws.monitorMarkerFile5.isEmpty()) {
-					lastText->setProperty("guid_text_monitor_marker_file_5", ws.monitorMarkerFile5);
-					if (QFile::exists(ws.monitorMarkerFile5)) {
-						textWatcher->addPath(ws.monitorMarkerFile5);
-						connect(textWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateText(QString)), Qt::UniqueConnection);
-					}
-
-					if (!ws.monitorVarName5.isEmpty())
-						lastText->setProperty("guid_text_monitor_var_name_5", ws.monitorVarName5);
-
-					if (!ws.defMarkerVal5.isEmpty())
-						lastText->setProperty("guid_text_def_marker_val_5", ws.defMarkerVal5);
-				}
-
-				if (!ws.monitorMarkerFile6.isEmpty()) {
-					lastText->setProperty("guid_text_monitor_marker_file_6", ws.monitorMarkerFile6);
-					if (QFile::exists(ws.monitorMarkerFile6)) {
-						textWatcher->addPath(ws.monitorMarkerFile6);
-						connect(textWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateText(QString)), Qt::UniqueConnection);
-					}
-
-					if (!ws.monitorVarName6.isEmpty())
-						lastText->setProperty("guid_text_monitor_var_name_6", ws.monitorVarName6);
-
-					if (!ws.defMarkerVal6.isEmpty())
-						lastText->setProperty("guid_text_def_marker_val_6", ws.defMarkerVal6);
-				}
-
-				if (!ws.monitorMarkerFile7.isEmpty()) {
-					lastText->setProperty("guid_text_monitor_marker_file_7", ws.monitorMarkerFile7);
-					if (QFile::exists(ws.monitorMarkerFile7)) {
-						textWatcher->addPath(ws.monitorMarkerFile7);
-						connect(textWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateText(QString)), Qt::UniqueConnection);
-					}
-
-					if (!ws.monitorVarName7.isEmpty())
-						lastText->setProperty("guid_text_monitor_var_name_7", ws.monitorVarName7);
-
-					if (!ws.defMarkerVal7.isEmpty())
-						lastText->setProperty("guid_text_def_marker_val_7", ws.defMarkerVal7);
-				}
-
-				if (!ws.monitorMarkerFile8.isEmpty()) {
-					lastText->setProperty("guid_text_monitor_marker_file_8", ws.monitorMarkerFile8);
-					if (QFile::exists(ws.monitorMarkerFile8)) {
-						textWatcher->addPath(ws.monitorMarkerFile8);
-						connect(textWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateText(QString)), Qt::UniqueConnection);
-					}
-
-					if (!ws.monitorVarName8.isEmpty())
-						lastText->setProperty("guid_text_monitor_var_name_8", ws.monitorVarName8);
-
-					if (!ws.defMarkerVal8.isEmpty())
-						lastText->setProperty("guid_text_def_marker_val_8", ws.defMarkerVal8);
-				}
-
-				if (!ws.monitorMarkerFile9.isEmpty()) {
-					lastText->setProperty("guid_text_monitor_marker_file_9", ws.monitorMarkerFile9);
-					if (QFile::exists(ws.monitorMarkerFile9)) {
-						textWatcher->addPath(ws.monitorMarkerFile9);
-						connect(textWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateText(QString)), Qt::UniqueConnection);
-					}
-
-					if (!ws.monitorVarName9.isEmpty())
-						lastText->setProperty("guid_text_monitor_var_name_9", ws.monitorVarName9);
-
-					if (!ws.defMarkerVal9.isEmpty())
-						lastText->setProperty("guid_text_def_marker_val_9", ws.defMarkerVal9);
+			WidgetMarkers textMarkers;
+			for (WidgetMarkers::const_iterator it = ws.markers.constBegin(); it != ws.markers.constEnd(); ++it) {
+				if (it.value().file.isEmpty())
+					continue;
+				textMarkers.insert(it.key(), it.value());
+				if (QFile::exists(it.value().file)) {
+					watchFile(it.value().file, lastText, WatchText, ws.poll);
 				}
+			}
 
+			if (!textMarkers.isEmpty()) {
+				editMeta(lastText).textMarkers = textMarkers;
 				setText(lastText);
 			}
 
@@ -3518,7 +6073,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// QLabel: --add-hrule
-		else if (args.at(i) == "--add-hrule") {
+		else if (option == Option::AddHrule) {
 			SWITCH_FORM_WIDGET("hrule")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3527,7 +6082,7 @@ char Guid::showForms(const QStringList& args) {
 			lastWidget = lastHRule;
 			lastHRuleLabel = new QLabel(ws.addLabel);
 
-			lastHRule->setProperty("guid_hide", false);
+			editMeta(lastHRule).hide = false;
 
 			lastHRuleCss = QString("color: " + next_arg + ";");
 			lastHRule->setContentsMargins(0, 0, 0, 0);
@@ -3541,7 +6096,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// QLabel: --add-vspacer
-		else if (args.at(i) == "--add-vspacer") {
+		else if (option == Option::AddVspacer) {
 			SWITCH_FORM_WIDGET("vspacer")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3564,7 +6119,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// QTextEdit: --add-text-info
-		else if (args.at(i) == "--add-text-info") {
+		else if (option == Option::AddTextInfo) {
 			SWITCH_FORM_WIDGET("text-info")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3575,21 +6130,21 @@ char Guid::showForms(const QStringList& args) {
 
 			lastTextInfo->setTextInteractionFlags(Qt::TextEditorInteraction);
 			lastTextInfo->setWordWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
-			lastTextInfo->setProperty("guid_text_info_nsep", "");
-			lastTextInfo->setProperty("guid_text_read_only", true);
-			lastTextInfo->setProperty("guid_text_format", "guess");
-			lastTextInfo->setProperty("guid_text_curl_path", "");
-			lastTextInfo->setProperty("guid_text_filename", "");
-			lastTextInfo->setProperty("guid_text_monitor_file", false);
-			lastTextInfo->setProperty("guid_text_is_url", false);
-			lastTextInfo->setProperty("guid_text_height", -1);
-			lastTextInfo->setProperty("guid_hide", false);
+			WidgetMeta& textInfoMeta = editMeta(lastTextInfo);
+			textInfoMeta.textInfoNsep = "";
+			textInfoMeta.textReadOnly = true;
+			textInfoMeta.textFormat = "guess";
+			textInfoMeta.textCurlPath = "";
+			textInfoMeta.textFilename = "";
+			textInfoMeta.textIsUrl = false;
+			textInfoMeta.textHeight = -1;
+			textInfoMeta.hide = false;
 
 			ADD_WIDGET_TO_FORM(lastTextInfoLabel, lastTextInfo)
 		}
 
 		// QTextBrowser: --add-text-browser
-		else if (args.at(i) == "--add-text-browser") {
+		else if (option == Option::AddTextBrowser) {
 			SWITCH_FORM_WIDGET("text-browser")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3602,20 +6157,20 @@ char Guid::showForms(const QStringList& args) {
 			lastTextBrowser->setOpenExternalLinks(true);
 			lastTextBrowser->setTextInteractionFlags(Qt::TextBrowserInteraction);
 			lastTextBrowser->setWordWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
-			lastTextBrowser->setProperty("guid_text_read_only", true);
-			lastTextBrowser->setProperty("guid_text_format", "html");
-			lastTextBrowser->setProperty("guid_text_curl_path", "");
-			lastTextBrowser->setProperty("guid_text_filename", "");
-			lastTextBrowser->setProperty("guid_text_monitor_file", false); // Not supported yet
-			lastTextBrowser->setProperty("guid_text_is_url", false);
-			lastTextBrowser->setProperty("guid_text_height", -1);
-			lastTextBrowser->setProperty("guid_hide", false);
+			WidgetMeta& textBrowserMeta = editMeta(lastTextBrowser);
+			textBrowserMeta.textReadOnly = true;
+			textBrowserMeta.textFormat = "html";
+			textBrowserMeta.textCurlPath = "";
+			textBrowserMeta.textFilename = "";
+			textBrowserMeta.textIsUrl = false;
+			textBrowserMeta.textHeight = -1;
+			textBrowserMeta.hide = false;
 
 			ADD_WIDGET_TO_FORM(lastTextBrowserLabel, lastTextBrowser)
 		}
 
 		// QComboBox: --add-combo
-		else if (args.at(i) == "--add-combo") {
+		else if (option == Option::AddCombo) {
 			SWITCH_FORM_WIDGET("combo")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3624,11 +6179,11 @@ char Guid::showForms(const QStringList& args) {
 			lastWidget = lastCombo;
 			lastComboLabel = new QLabel(next_arg);
 
-			lastCombo->setProperty("guid_hide", false);
-			lastCombo->setProperty("guid_file_sep", "");
-			lastCombo->setProperty("guid_file_path", "");
-			lastCombo->setProperty("guid_monitor_file", false);
-			lastCombo->setProperty("guid_combo_default_index", 0);
+			WidgetMeta& comboMeta = editMeta(lastCombo);
+			comboMeta.hide = false;
+			comboMeta.fileSep = "";
+			comboMeta.monitorFile = false;
+			comboMeta.comboDefaultIndex = 0;
 
 			ADD_WIDGET_TO_FORM(lastComboLabel, lastCombo)
 
@@ -3636,7 +6191,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// QTreeWidget: --add-list
-		else if (args.at(i) == "--add-list") {
+		else if (option == Option::AddList) {
 			SWITCH_FORM_WIDGET("list")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3655,16 +6210,16 @@ char Guid::showForms(const QStringList& args) {
 			lastListLayout = new QFormLayout();
 			lastListContainer = new QWidget();
 
-			lastList->setProperty("guid_hide", false);
-			lastList->setProperty("guid_file_sep", "");
-			lastList->setProperty("guid_file_path", "");
-			lastList->setProperty("guid_monitor_file", false);
-			lastList->setProperty("guid_list_add_value", "");
-			lastList->setProperty("guid_list_print_values_mode", "selected");
-			lastList->setProperty("guid_list_selection_type", "");
-			lastList->setProperty("guid_list_print_column", "1");
-			lastList->setProperty("guid_list_read_only_column", -1);
-			lastList->setProperty("guid_list_exclude_from_output", false);
+			WidgetMeta& listMeta = editMeta(lastList);
+			listMeta.hide = false;
+			listMeta.fileSep = "";
+			listMeta.monitorFile = false;
+			listMeta.listAddValue = "";
+			listMeta.listPrintValuesMode = "selected";
+			listMeta.listSelectionType = "";
+			listMeta.listPrintColumn = "1";
+			listMeta.listReadOnlyColumn = -1;
+			listMeta.listExcludeFromOutput = false;
 			lastList->setSizeAdjustPolicy(QAbstractScrollArea::AdjustToContents);
 			lastList->header()->setStretchLastSection(true);
 
@@ -3680,16 +6235,16 @@ char Guid::showForms(const QStringList& args) {
 				lastListLayout->setAlignment(lastListButton, Qt::AlignLeft);
 			}
 
-			lastList->setProperty("guid_list_exclude_from_output", ws.excludeFromOutput);
+			editMeta(lastList).listExcludeFromOutput = ws.excludeFromOutput;
 
 			lastListContainer->setLayout(lastListLayout);
-			lastListContainer->setProperty("guid_list_container", true);
+			editMeta(lastListContainer).container = WidgetMeta::ListContainer;
 
 			ADD_WIDGET_TO_FORM(lastListLabel, lastListContainer)
 		}
 
 		// QrCode: --add-qr-code
-		else if (args.at(i) == "--add-qr-code") {
+		else if (option == Option::AddQrCode) {
 			SWITCH_FORM_WIDGET("qr-code")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3698,7 +6253,7 @@ char Guid::showForms(const QStringList& args) {
 			lastWidget = lastQRCodeContainer;
 			lastQRCodeLabel = new QLabel(ws.addLabel);
 
-			lastQRCodeContainer->setProperty("guid_hide", false);
+			editMeta(lastQRCodeContainer).hide = false;
 
 			if (ws.addLabel.isEmpty())
 				ws.hideLabel = true;
@@ -3709,7 +6264,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// QSlider: --add-scale
-		else if (args.at(i) == "--add-scale") {
+		else if (option == Option::AddScale) {
 			SWITCH_FORM_WIDGET("scale")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3718,8 +6273,8 @@ char Guid::showForms(const QStringList& args) {
 			lastWidget = lastScale;
 			lastScaleLabel = new QLabel(next_arg);
 
-			lastScale->setProperty("guid_hide", false);
-			lastScale->setProperty("guid_scale_default", INT_MIN);
+			editMeta(lastScale).hide = false;
+			editMeta(lastScale).scaleDefault = INT_MIN;
 			lastScale->setRange(0, 100);
 			lastScaleVal = new QLabel(dlg);
 			lastScaleVal->setNum(0);
@@ -3731,14 +6286,14 @@ char Guid::showForms(const QStringList& args) {
 			scaleHBoxLayout->addWidget(lastScaleVal);
 
 			scaleContainer = new QWidget();
-			scaleContainer->setProperty("guid_scale_container", true);
+			editMeta(scaleContainer).container = WidgetMeta::ScaleContainer;
 			scaleContainer->setLayout(scaleHBoxLayout);
 
 			ADD_WIDGET_TO_FORM(lastScaleLabel, scaleContainer)
 		}
 
 		// QLabel: --text (form label)
-		else if (args.at(i) == "--text") {
+		else if (option == Option::Text) {
 			SWITCH_FORM_WIDGET("form-label")
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
@@ -3761,7 +6316,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --add-hspacer
-		else if (args.at(i) == "--add-hspacer") {
+		else if (option == Option::AddHspacer) {
 			next_arg = NEXT_ARG;
 			QString hSpacer = next_arg;
 			if (lastColumn == "col1") {
@@ -3774,7 +6329,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --valign
-		else if (args.at(i) == "--valign") {
+		else if (option == Option::Valign) {
 			next_arg = NEXT_ARG;
 			if (lastColumn == "col1" || lastColumn == "col2") {
 				QString alignment = next_arg;
@@ -3806,7 +6361,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --tab-visible
-		else if (args.at(i) == "--tab-visible") {
+		else if (option == Option::TabVisible) {
 			if (!lastTabName.isEmpty()) {
 				lastTabBar->setCurrentIndex(lastTabIndex);
 			} else {
@@ -3824,12 +6379,12 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --hide
-		else if (args.at(i) == "--hide") {
+		else if (option == Option::Hide) {
 			if (lastWidgetId == "calendar" || lastWidgetId == "checkbox" || lastWidgetId == "entry" || lastWidgetId == "file-sel" || lastWidgetId == "menu" || lastWidgetId == "password" || lastWidgetId == "spin-box" || lastWidgetId == "double-spin-box" || lastWidgetId == "qr-code" || lastWidgetId == "scale" || lastWidgetId == "combo" || lastWidgetId == "list" || lastWidgetId == "text" || lastWidgetId == "hrule" || lastWidgetId == "text-info" || lastWidgetId == "text-browser") {
 				QSizePolicy hideSizePolicy = lastWidget->sizePolicy();
 				hideSizePolicy.setRetainSizeWhenHidden(true);
 				lastWidget->setSizePolicy(hideSizePolicy);
-				lastWidget->setProperty("guid_hide", true);
+				editMeta(lastWidget).hide = true;
 				lastWidget->hide();
 			} else {
 				WARN_UNKNOWN_ARG("--add-entry");
@@ -3841,10 +6396,10 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --checked
-		else if (args.at(i) == "--checked") {
+		else if (option == Option::Checked) {
 			if (lastWidgetId == "checkbox") {
 				lastCheckbox->setCheckState(Qt::Checked);
-				lastCheckbox->setProperty("guid_checkbox_default", "checked");
+				editMeta(lastCheckbox).checkboxDefault = true;
 			} else {
 				WARN_UNKNOWN_ARG("--add-checkbox");
 			}
@@ -3855,9 +6410,9 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --var
-		else if (args.at(i) == "--var") {
+		else if (option == Option::Var) {
 			next_arg = NEXT_ARG;
-			if (lastWidgetId == "calendar" || lastWidgetId == "checkbox" || lastWidgetId == "entry" || lastWidgetId == "password" || lastWidgetId == "spin-box" || lastWidgetId == "double-spin-box" || lastWidgetId == "scale" || lastWidgetId == "combo" || lastWidgetId == "list" || lastWidgetId == "text-info" || lastWidgetId == "file-sel") {
+			if (lastWidgetId == "calendar" || lastWidgetId == "checkbox" || lastWidgetId == "entry" || lastWidgetId == "password" || lastWidgetId == "spin-box" || lastWidgetId == "double-spin-box" || lastWidgetId == "scale" || lastWidgetId == "combo" || lastWidgetId == "list" || lastWidgetId == "text-info" || lastWidgetId == "file-sel" || lastWidgetId == "text") {
 				lastWidgetVar = next_arg;
 			} else {
 				WARN_UNKNOWN_ARG("--add-entry");
@@ -3869,7 +6424,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --int
-		else if (args.at(i) == "--int") {
+		else if (option == Option::Int) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "entry") {
 				lastEntry->setValidator(new QIntValidator(INT_MIN, INT_MAX, this));
@@ -3880,7 +6435,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --float
-		else if (args.at(i) == "--float") {
+		else if (option == Option::Float) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "entry") {
 				QLocale dv_locale(QLocale::C);
@@ -3902,7 +6457,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --field-width
-		else if (args.at(i) == "--field-width") {
+		else if (option == Option::FieldWidth) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "entry") {
 				lastEntry->setMaximumWidth(next_arg.toInt());
@@ -3935,7 +6490,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --prefix
-		else if (args.at(i) == "--prefix") {
+		else if (option == Option::Prefix) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "spin-box")
 				lastSpinBox->setPrefix(next_arg);
@@ -3946,7 +6501,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --suffix
-		else if (args.at(i) == "--suffix") {
+		else if (option == Option::Suffix) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "spin-box")
 				lastSpinBox->setSuffix(next_arg);
@@ -3961,7 +6516,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --decimals
-		else if (args.at(i) == "--decimals") {
+		else if (option == Option::Decimals) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "double-spin-box")
 				lastDoubleSpinBox->setDecimals(next_arg.toInt());
@@ -3974,24 +6529,24 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --value
-		else if (args.at(i) == "--value") {
+		else if (option == Option::Value) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "spin-box") {
 				lastSpinBox->setValue(next_arg.toInt());
-				lastSpinBox->setProperty("guid_spin_box_default", next_arg.toInt());
+				editMeta(lastSpinBox).spinBoxDefault = next_arg.toInt();
 			} else if (lastWidgetId == "double-spin-box") {
 				lastDoubleSpinBox->setValue(next_arg.toDouble());
-				lastDoubleSpinBox->setProperty("guid_double_spin_box_default", next_arg.toDouble());
+				editMeta(lastDoubleSpinBox).doubleSpinBoxDefault = next_arg.toDouble();
 			} else if (lastWidgetId == "scale") {
 				lastScale->setValue(next_arg.toInt());
-				lastScale->setProperty("guid_scale_default", next_arg.toInt());
+				editMeta(lastScale).scaleDefault = next_arg.toInt();
 			} else {
 				WARN_UNKNOWN_ARG("--add-spin-box");
 			}
 		}
 
 		// --min-value
-		else if (args.at(i) == "--min-value") {
+		else if (option == Option::MinValue) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "spin-box") {
 				lastSpinBox->setMinimum(next_arg.toInt());
@@ -4005,7 +6560,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --max-value
-		else if (args.at(i) == "--max-value") {
+		else if (option == Option::MaxValue) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "spin-box") {
 				lastSpinBox->setMaximum(next_arg.toInt());
@@ -4023,7 +6578,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --step
-		else if (args.at(i) == "--step") {
+		else if (option == Option::Step) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "scale")
 				lastScale->setSingleStep(next_arg.toInt());
@@ -4032,7 +6587,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --print-partial
-		else if (args.at(i) == "--print-partial") {
+		else if (option == Option::PrintPartial) {
 			if (lastWidgetId == "scale")
 				connect(lastScale, SIGNAL(valueChanged(int)), SLOT(printInteger(int)));
 			else
@@ -4040,7 +6595,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --hide-value
-		else if (args.at(i) == "--hide-value") {
+		else if (option == Option::HideValue) {
 			if (lastWidgetId == "scale")
 				lastScaleVal->hide();
 			else
@@ -4052,7 +6607,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --combo-values
-		else if (args.at(i) == "--combo-values") {
+		else if (option == Option::ComboValues) {
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
 
@@ -4061,7 +6616,7 @@ char Guid::showForms(const QStringList& args) {
 				lastCombo->addItems(lastComboGList.val);
 				if (ws.defaultIndex > 0 && ws.defaultIndex < lastCombo->count()) {
 					lastCombo->setCurrentIndex(ws.defaultIndex);
-					lastCombo->setProperty("guid_combo_default_index", ws.defaultIndex);
+					editMeta(lastCombo).comboDefaultIndex = ws.defaultIndex;
 				}
 			} else {
 				WARN_UNKNOWN_ARG("--add-combo");
@@ -4069,26 +6624,24 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --combo-values-from-file
-		else if (args.at(i) == "--combo-values-from-file") {
+		else if (option == Option::ComboValuesFromFile) {
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
 
 			if (lastWidgetId == "combo") {
 				lastComboGList = listValuesFromFile(next_arg);
 
-				lastCombo->setProperty("guid_file_sep", lastComboGList.fileSep);
-				lastCombo->setProperty("guid_file_path", lastComboGList.filePath);
-				lastCombo->setProperty("guid_monitor_file", lastComboGList.monitorFile);
+				editMeta(lastCombo).fileSep = lastComboGList.fileSep;
+				editMeta(lastCombo).monitorFile = lastComboGList.monitorFile || ws.monitorFile || ws.poll > 0;
 
-				if (QFile::exists(lastComboGList.filePath)) {
-					comboWatcher->addPath(lastComboGList.filePath);
-					connect(comboWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateCombo(QString)), Qt::UniqueConnection);
+				if (meta(lastCombo).monitorFile && QFile::exists(lastComboGList.filePath)) {
+					watchFile(lastComboGList.filePath, lastCombo, WatchCombo, ws.poll > 0 ? ws.poll : lastComboGList.pollInterval);
 				}
 
 				lastCombo->addItems(lastComboGList.val);
 				if (ws.defaultIndex > 0 && ws.defaultIndex < lastCombo->count()) {
 					lastCombo->setCurrentIndex(ws.defaultIndex);
-					lastCombo->setProperty("guid_combo_default_index", ws.defaultIndex);
+					editMeta(lastCombo).comboDefaultIndex = ws.defaultIndex;
 				}
 			} else {
 				WARN_UNKNOWN_ARG("--add-combo");
@@ -4100,13 +6653,13 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --editable
-		else if (args.at(i) == "--editable") {
+		else if (option == Option::Editable) {
 			if (lastWidgetId == "list")
 				lastListFlags |= Qt::ItemIsEditable;
 			else if (lastWidgetId == "combo")
 				lastCombo->setEditable(true);
 			else if (lastWidgetId == "text-info")
-				lastTextInfo->setProperty("guid_text_read_only", false);
+				editMeta(lastTextInfo).textReadOnly = false;
 			else
 				WARN_UNKNOWN_ARG("--add-list");
 		}
@@ -4116,7 +6669,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --field-height
-		else if (args.at(i) == "--field-height") {
+		else if (option == Option::FieldHeight) {
 			next_arg = NEXT_ARG;
 			int fieldHeight = next_arg.toInt(&ok);
 			if (!ok || fieldHeight < 0)
@@ -4130,9 +6683,9 @@ char Guid::showForms(const QStringList& args) {
 				lastHRule->setFixedHeight(fieldHeight);
 			} else if (lastWidgetId == "text-browser" || lastWidgetId == "text-info") {
 				if (lastWidgetId == "text-browser")
-					lastTextBrowser->setProperty("guid_text_height", fieldHeight);
+					editMeta(lastTextBrowser).textHeight = fieldHeight;
 				else if (lastWidgetId == "text-info")
-					lastTextInfo->setProperty("guid_text_height", fieldHeight);
+					editMeta(lastTextInfo).textHeight = fieldHeight;
 			} else {
 				WARN_UNKNOWN_ARG("--add-list");
 			}
@@ -4143,7 +6696,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --column-values
-		else if (args.at(i) == "--column-values") {
+		else if (option == Option::ColumnValues) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "list")
 				lastListColumns = next_arg.split('|');
@@ -4152,16 +6705,16 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --print-column
-		else if (args.at(i) == "--print-column") {
+		else if (option == Option::PrintColumn) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "list")
-				lastList->setProperty("guid_list_print_column", next_arg.toLower());
+				editMeta(lastList).listPrintColumn = next_arg.toLower();
 			else
 				WARN_UNKNOWN_ARG("--add-list");
 		}
 
 		// --list-values
-		else if (args.at(i) == "--list-values") {
+		else if (option == Option::ListValues) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "list")
 				lastListGList.val = next_arg.split('|');
@@ -4170,19 +6723,18 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --list-values-from-file
-		else if (args.at(i) == "--list-values-from-file") {
+		else if (option == Option::ListValuesFromFile) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "list") {
 				lastListGList = listValuesFromFile(next_arg);
 
-				lastList->setProperty("guid_list_add_value", lastListGList.addValue);
-				lastList->setProperty("guid_file_sep", lastListGList.fileSep);
-				lastList->setProperty("guid_file_path", lastListGList.filePath);
-				lastList->setProperty("guid_monitor_file", lastListGList.monitorFile);
+				WidgetMeta& listMeta = editMeta(lastList);
+				listMeta.listAddValue = lastListGList.addValue;
+				listMeta.fileSep = lastListGList.fileSep;
+				listMeta.monitorFile = lastListGList.monitorFile;
 
-				if (QFile::exists(lastListGList.filePath)) {
-					listWatcher->addPath(lastListGList.filePath);
-					connect(listWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateList(QString)), Qt::UniqueConnection);
+				if (lastListGList.monitorFile && QFile::exists(lastListGList.filePath)) {
+					watchFile(lastListGList.filePath, lastList, WatchList, lastListGList.pollInterval);
 				}
 			} else {
 				WARN_UNKNOWN_ARG("--add-list");
@@ -4190,32 +6742,32 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --print-values
-		else if (args.at(i) == "--print-values") {
+		else if (option == Option::PrintValues) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "list")
-				lastList->setProperty("guid_list_print_values_mode", next_arg.toLower());
+				editMeta(lastList).listPrintValuesMode = next_arg.toLower();
 			else
 				WARN_UNKNOWN_ARG("--add-list");
 		}
 
 		// --checklist
-		else if (args.at(i) == "--checklist") {
+		else if (option == Option::Checklist) {
 			if (lastWidgetId == "list")
-				lastList->setProperty("guid_list_selection_type", "checklist");
+				editMeta(lastList).listSelectionType = "checklist";
 			else
 				WARN_UNKNOWN_ARG("--add-list");
 		}
 
 		// --radiolist
-		else if (args.at(i) == "--radiolist") {
+		else if (option == Option::Radiolist) {
 			if (lastWidgetId == "list")
-				lastList->setProperty("guid_list_selection_type", "radiolist");
+				editMeta(lastList).listSelectionType = "radiolist";
 			else
 				WARN_UNKNOWN_ARG("--add-list");
 		}
 
 		// --no-selection
-		else if (args.at(i) == "--no-selection") {
+		else if (option == Option::NoSelection) {
 			if (lastWidgetId == "list") {
 				lastList->setSelectionMode(QAbstractItemView::NoSelection);
 				lastList->setFocusPolicy(Qt::NoFocus);
@@ -4225,20 +6777,20 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --read-only-column
-		else if (args.at(i) == "--read-only-column") {
+		else if (option == Option::ReadOnlyColumn) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "list") {
 				int roColumnNumber = next_arg.toInt(&ok);
 				if (!ok)
 					roColumnNumber = -1;
-				lastList->setProperty("guid_list_read_only_column", roColumnNumber);
+				editMeta(lastList).listReadOnlyColumn = roColumnNumber;
 			} else {
 				WARN_UNKNOWN_ARG("--add-list");
 			}
 		}
 
 		// --show-header
-		else if (args.at(i) == "--show-header") {
+		else if (option == Option::ShowHeader) {
 			if (lastWidgetId == "list")
 				lastListHeader = true;
 			else
@@ -4250,7 +6802,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --multiple
-		else if (args.at(i) == "--multiple") {
+		else if (option == Option::Multiple) {
 			if (lastWidgetId == "list") {
 				lastList->setSelectionMode(QAbstractItemView::ExtendedSelection);
 			} else if (lastWidgetId == "file-sel") {
@@ -4265,7 +6817,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --directory
-		else if (args.at(i) == "--directory") {
+		else if (option == Option::Directory) {
 			if (lastWidgetId == "file-sel") {
 				lastFileSel->setFileMode(QFileDialog::Directory);
 				lastFileSel->setOption(QFileDialog::ShowDirsOnly);
@@ -4275,7 +6827,7 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --file-filter
-		else if (args.at(i) == "--file-filter") {
+		else if (option == Option::FileFilter) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "file-sel") {
 				QStringList lastFileSelMimeFilters;
@@ -4292,10 +6844,10 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --file-separator
-		else if (args.at(i) == "--file-separator") {
+		else if (option == Option::FileSeparator) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "file-sel") {
-				lastFileSel->setProperty("guid_file_sel_separator", next_arg);
+				editMeta(lastFileSel).fileSelSeparator = next_arg;
 			} else {
 				WARN_UNKNOWN_ARG("--add-file-selection");
 			}
@@ -4306,7 +6858,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --no-bold
-		else if (args.at(i) == "--no-bold") {
+		else if (option == Option::NoBold) {
 			formLabelInBold = false;
 		}
 
@@ -4315,13 +6867,13 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --tooltip
-		else if (args.at(i) == "--tooltip") {
+		else if (option == Option::Tooltip) {
 			next_arg = NEXT_ARG;
 			lastText->setToolTip(next_arg);
 		}
 
 		// --wrap
-		else if (args.at(i) == "--wrap") {
+		else if (option == Option::Wrap) {
 			lastText->setWordWrap(true);
 		}
 
@@ -4331,7 +6883,7 @@ char Guid::showForms(const QStringList& args) {
 
 		// --align || --bold || --italics || --underline || --small-caps || --font-family || --font-size ||
 		// --foreground-color || --background-color
-		else if (args.at(i) == "--align" || args.at(i) == "--bold" || args.at(i) == "--italics" || args.at(i) == "--underline" || args.at(i) == "--small-caps" || args.at(i) == "--font-family" || args.at(i) == "--font-size" || args.at(i) == "--foreground-color" || args.at(i) == "--background-color") {
+		else if (option == Option::Align || option == Option::Bold || option == Option::Italics || option == Option::Underline || option == Option::SmallCaps || option == Option::FontFamily || option == Option::FontSize || option == Option::ForegroundColor || option == Option::BackgroundColor) {
 			QLabel* labelToSet = NULL;
 			if (lastWidgetId == "form-label") {
 				labelToSet = formLabel;
@@ -4343,7 +6895,7 @@ char Guid::showForms(const QStringList& args) {
 			if (labelToSet) {
 				QFont fontToSet = labelToSet->font();
 
-				if (args.at(i) == "--align") {
+				if (option == Option::Align) {
 					next_arg = NEXT_ARG;
 					QString alignment = next_arg;
 					if (alignment == "left") {
@@ -4355,30 +6907,30 @@ char Guid::showForms(const QStringList& args) {
 					} else {
 						qOutErr << m_prefixErr + "argument --align: unknown value" << args.at(i) << Qt::endl;
 					}
-				} else if (args.at(i) == "--bold") {
+				} else if (option == Option::Bold) {
 					fontToSet.setBold(true);
 					labelToSet->setFont(fontToSet);
-				} else if (args.at(i) == "--italics") {
+				} else if (option == Option::Italics) {
 					fontToSet.setItalic(true);
 					labelToSet->setFont(fontToSet);
-				} else if (args.at(i) == "--underline") {
+				} else if (option == Option::Underline) {
 					fontToSet.setUnderline(true);
 					labelToSet->setFont(fontToSet);
-				} else if (args.at(i) == "--small-caps") {
+				} else if (option == Option::SmallCaps) {
 					fontToSet.setCapitalization(QFont::SmallCaps);
 					labelToSet->setFont(fontToSet);
-				} else if (args.at(i) == "--font-family") {
+				} else if (option == Option::FontFamily) {
 					next_arg = NEXT_ARG;
 					fontToSet.setFamily(next_arg);
 					labelToSet->setFont(fontToSet);
-				} else if (args.at(i) == "--font-size") {
+				} else if (option == Option::FontSize) {
 					next_arg = NEXT_ARG;
 					int fontSize = next_arg.toInt(&ok);
 					if (ok) {
 						fontToSet.setPointSize(fontSize);
 						labelToSet->setFont(fontToSet);
 					}
-				} else if (args.at(i) == "--foreground-color") {
+				} else if (option == Option::ForegroundColor) {
 					next_arg = NEXT_ARG;
 					QString foregroundColor = next_arg;
 					if (foregroundColor.left(1) != "#") {
@@ -4392,7 +6944,7 @@ char Guid::showForms(const QStringList& args) {
 					labelPalette.setColor(QPalette::WindowText, *color);
 
 					labelToSet->setPalette(labelPalette);
-				} else if (args.at(i) == "--background-color") {
+				} else if (option == Option::BackgroundColor) {
 					next_arg = NEXT_ARG;
 					QString backgroundColor = next_arg;
 					if (backgroundColor.left(1) != "#") {
@@ -4412,7 +6964,7 @@ char Guid::showForms(const QStringList& args) {
 
 			// text-info
 			else if (lastWidgetId == "text-info") {
-				if (args.at(i) == "--align") {
+				if (option == Option::Align) {
 					next_arg = NEXT_ARG;
 					QString alignment = next_arg;
 					if (alignment == "left") {
@@ -4424,22 +6976,22 @@ char Guid::showForms(const QStringList& args) {
 					} else {
 						qOutErr << m_prefixErr + "argument --align: unknown value" << args.at(i) << Qt::endl;
 					}
-				} else if (args.at(i) == "--bold") {
+				} else if (option == Option::Bold) {
 					lastTextInfo->setFontWeight(QFont::Bold);
-				} else if (args.at(i) == "--italics") {
+				} else if (option == Option::Italics) {
 					lastTextInfo->setFontItalic(true);
-				} else if (args.at(i) == "--underline") {
+				} else if (option == Option::Underline) {
 					lastTextInfo->setFontUnderline(true);
-				} else if (args.at(i) == "--font-family") {
+				} else if (option == Option::FontFamily) {
 					next_arg = NEXT_ARG;
 					lastTextInfo->setFontFamily(next_arg);
-				} else if (args.at(i) == "--font-size") {
+				} else if (option == Option::FontSize) {
 					next_arg = NEXT_ARG;
 					int fontSize = next_arg.toDouble(&ok);
 					if (ok) {
 						lastTextInfo->setFontPointSize(fontSize);
 					}
-				} else if (args.at(i) == "--foreground-color") {
+				} else if (option == Option::ForegroundColor) {
 					next_arg = NEXT_ARG;
 					QString foregroundColor = next_arg;
 					if (foregroundColor.left(1) != "#") {
@@ -4449,7 +7001,7 @@ char Guid::showForms(const QStringList& args) {
 					QColor color = QColor(0, 0, 0);
 					color.setNamedColor(foregroundColor);
 					lastTextInfo->setTextColor(color);
-				} else if (args.at(i) == "--background-color") {
+				} else if (option == Option::BackgroundColor) {
 					next_arg = NEXT_ARG;
 					QString backgroundColor = next_arg;
 					if (backgroundColor.left(1) != "#") {
@@ -4463,7 +7015,7 @@ char Guid::showForms(const QStringList& args) {
 
 			// qr-code
 			else if (lastWidgetId == "qr-code") {
-				if (args.at(i) == "--align") {
+				if (option == Option::Align) {
 					next_arg = NEXT_ARG;
 					QString alignment = next_arg;
 					if (alignment == "left") {
@@ -4489,7 +7041,7 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --font
-		else if (args.at(i) == "--font") {
+		else if (option == Option::Font) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "text-info") {
 				lastTextInfo->setFont(QFont(next_arg));
@@ -4499,28 +7051,28 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --html
-		else if (args.at(i) == "--html") {
+		else if (option == Option::Html) {
 			if (lastWidgetId == "text-info") {
-				lastTextInfo->setProperty("guid_text_format", "html");
+				editMeta(lastTextInfo).textFormat = "html";
 			} else {
 				WARN_UNKNOWN_ARG("--add-text-info");
 			}
 		}
 
 		// --plain
-		else if (args.at(i) == "--plain") {
+		else if (option == Option::Plain) {
 			if (lastWidgetId == "text-info") {
-				lastTextInfo->setProperty("guid_text_format", "plain");
+				editMeta(lastTextInfo).textFormat = "plain";
 			} else {
 				WARN_UNKNOWN_ARG("--add-text-info");
 			}
 		}
 
 		// --newline-separator
-		else if (args.at(i) == "--newline-separator") {
+		else if (option == Option::NewlineSeparator) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "text-info") {
-				lastTextInfo->setProperty("guid_text_info_nsep", next_arg);
+				editMeta(lastTextInfo).textInfoNsep = next_arg;
 			} else {
 				WARN_UNKNOWN_ARG("--add-text-info");
 			}
@@ -4531,26 +7083,26 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --url
-		else if (args.at(i) == "--url") {
+		else if (option == Option::Url) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "text-browser") {
-				lastTextBrowser->setProperty("guid_text_filename", next_arg);
-				lastTextBrowser->setProperty("guid_text_is_url", true);
+				editMeta(lastTextBrowser).textFilename = next_arg;
+				editMeta(lastTextBrowser).textIsUrl = true;
 			} else if (lastWidgetId == "text-info") {
-				lastTextInfo->setProperty("guid_text_filename", next_arg);
-				lastTextInfo->setProperty("guid_text_is_url", true);
+				editMeta(lastTextInfo).textFilename = next_arg;
+				editMeta(lastTextInfo).textIsUrl = true;
 			} else {
 				WARN_UNKNOWN_ARG("--text-info");
 			}
 		}
 
 		// --curl-path
-		else if (args.at(i) == "--curl-path") {
+		else if (option == Option::CurlPath) {
 			next_arg = NEXT_ARG;
 			if (lastWidgetId == "text-browser")
-				lastTextBrowser->setProperty("guid_text_curl_path", next_arg);
+				editMeta(lastTextBrowser).textCurlPath = next_arg;
 			else if (lastWidgetId == "text-info")
-				lastTextInfo->setProperty("guid_text_curl_path", next_arg);
+				editMeta(lastTextInfo).textCurlPath = next_arg;
 			else
 				WARN_UNKNOWN_ARG("--text-info");
 		}
@@ -4560,20 +7112,18 @@ char Guid::showForms(const QStringList& args) {
          ******************************/
 
 		// --filename
-		else if (args.at(i) == "--filename") {
+		else if (option == Option::Filename) {
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
 
 			if (lastWidgetId == "text-browser") {
-				lastTextBrowser->setProperty("guid_text_filename", next_arg);
+				editMeta(lastTextBrowser).textFilename = next_arg;
 			} else if (lastWidgetId == "text-info") {
-				lastTextInfo->setProperty("guid_text_filename", next_arg);
-				if (ws.monitorFile) {
-					lastTextInfo->setProperty("guid_text_monitor_file", true);
+				editMeta(lastTextInfo).textFilename = next_arg;
+				editMeta(lastTextInfo).follow = ws.follow;
+				if (ws.monitorFile || ws.follow || ws.poll > 0) {
 					if (QFile::exists(next_arg)) {
-						textInfoWatcher->addPath(next_arg);
-						connect(textInfoWatcher, SIGNAL(fileChanged(QString)),
-						    this, SLOT(updateTextInfo(QString)), Qt::UniqueConnection);
+						watchFile(next_arg, lastTextInfo, WatchTextInfo, ws.poll);
 					}
 				}
 			} else if (lastWidgetId == "file-sel") {
@@ -4592,21 +7142,21 @@ char Guid::showForms(const QStringList& args) {
          ********************************************************************************/
 
 		// --win-min-button
-		else if (args.at(i) == "--win-min-button") {
+		else if (option == Option::WinMinButton) {
 			dlgFlags = dlg->windowFlags();
 			dlgFlags |= Qt::WindowMinimizeButtonHint;
 			dlg->setWindowFlags(dlgFlags);
 		}
 
 		// --win-max-button
-		else if (args.at(i) == "--win-max-button") {
+		else if (option == Option::WinMaxButton) {
 			dlgFlags = dlg->windowFlags();
 			dlgFlags |= Qt::WindowMaximizeButtonHint;
 			dlg->setWindowFlags(dlgFlags);
 		}
 
 		// --action-after-ok-click
-		else if (args.at(i) == "--action-after-ok-click") {
+		else if (option == Option::ActionAfterOkClick) {
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
 
@@ -4630,60 +7180,67 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --no-cancel
-		else if (args.at(i) == "--no-cancel") {
+		else if (option == Option::NoCancel) {
 			noCancelButton = true;
 		}
 
 		// --close-to-systray
-		else if (args.at(i) == "--close-to-systray") {
+		else if (option == Option::CloseToSystray) {
 			m_closeToSysTray = true;
 		}
 
 		// --systray-icon
-		else if (args.at(i) == "--systray-icon") {
+		else if (option == Option::SystrayIcon) {
 			next_arg = NEXT_ARG;
 			sysTrayIconPath = next_arg;
 		}
 
 		// --footer-name
-		else if (args.at(i) == "--footer-name") {
+		else if (option == Option::FooterName) {
 			next_arg = NEXT_ARG;
 			footer->setTitle(next_arg);
 		}
 
 		// --footer-entries
-		else if (args.at(i) == "--footer-entries") {
+		else if (option == Option::FooterEntries) {
 			next_arg = NEXT_ARG;
 			int nbFooterEntries = next_arg.toInt(&ok);
 			if (ok && nbFooterEntries > 0)
-				footer->setProperty("guid_footer_nb_entries", nbFooterEntries);
+				editMeta(footer).footerNbEntries = nbFooterEntries;
 		}
 
 		// --footer-from-file
-		else if (args.at(i) == "--footer-from-file") {
+		else if (option == Option::FooterFromFile) {
 			next_arg = NEXT_ARG;
 			SET_WIDGET_SETTINGS(next_arg)
 
 			if (QFile::exists(next_arg)) {
-				footer->setProperty("guid_footer_file_path", next_arg);
+				editMeta(footer).follow = ws.follow;
 				updateFooterContentFromFile(footer, next_arg);
 
-				if (ws.monitorFile) {
-					footer->setProperty("guid_footer_monitor_file", true);
-					footerWatcher->addPath(next_arg);
-					connect(footerWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateFooter(QString)), Qt::UniqueConnection);
+				if (ws.monitorFile || ws.follow || ws.poll > 0) {
+					watchFile(next_arg, footer, WatchFooter, ws.poll);
 				}
 			}
 		}
 
+		// --control
+		else if (option == Option::Control) {
+			next_arg = NEXT_ARG;
+			if (next_arg == "stdin")
+				listenToStdIn();
+			else
+				qOutErr << m_prefixErr + "argument --control: unknown value" << next_arg << Qt::endl;
+		}
+
 		// --forms-date-format
-		else if (args.at(i) == "--forms-date-format") {
+		else if (option == Option::FormsDateFormat) {
 			next_arg = NEXT_ARG;
-			dlg->setProperty("guid_date_format", next_arg);
+			editMeta(dlg).dateFormat = next_arg;
 		}
 
 		// --forms-align
-		else if (args.at(i) == "--forms-align") {
+		else if (option == Option::FormsAlign) {
 			next_arg = NEXT_ARG;
 			QString alignment = next_arg;
 			if (alignment == "left") {
@@ -4698,19 +7255,38 @@ char Guid::showForms(const QStringList& args) {
 		}
 
 		// --separator
-		else if (args.at(i) == "--separator") {
+		else if (option == Option::Separator) {
 			next_arg = NEXT_ARG;
-			dlg->setProperty("guid_separator", next_arg);
+			editMeta(dlg).separator = next_arg;
 		}
 
 		// --list-row-separator
-		else if (args.at(i) == "--list-row-separator") {
+		else if (option == Option::ListRowSeparator) {
 			next_arg = NEXT_ARG;
-			dlg->setProperty("guid_list_row_separator", next_arg);
+			editMeta(dlg).listRowSeparator = next_arg;
+		}
+
+		// --output-format
+		else if (option == Option::OutputFormat) {
+			next_arg = NEXT_ARG;
+			if (!outputFormatFromName(next_arg, editMeta(dlg).outputFormat))
+				qOutErr << m_prefixErr + "argument --output-format: unknown value" << next_arg << Qt::endl;
+		}
+
+		// --emit-changes[=MS]
+		else if (option == Option::EmitChanges) {
+			bool isInterval;
+			const int interval = args.value(i + 1).toInt(&isInterval);
+			if (isInterval) {
+				++i;
+				m_changeInterval = qMax(0, interval);
+			} else {
+				m_changeInterval = 100;
+			}
 		}
 
 		// --comment
-		else if (args.at(i) == "--comment") {
+		else if (option == Option::Comment) {
 			next_arg = NEXT_ARG;
 		}
 
@@ -4742,6 +7318,78 @@ char Guid::showForms(const QStringList& args) {
 	FINISH_DIALOG(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
 	btns->setContentsMargins(wSpacing, 0, wSpacing, wSpacing);
 
+	// What printForms() outputs, in order
+	const QString separator = meta(dlg).separator;
+	const bool keyedOutput = meta(dlg).outputFormat != OutputFormat::Text;
+	bool hasValue = false;
+	int fieldNo = 0;
+	for (int i = 0; i < fl->count(); ++i) {
+		QLayoutItem* li = fl->itemAt(i, QFormLayout::FieldRole);
+		if (!li)
+			continue;
+		if (keyedOutput) {
+			addFormsFieldSteps(li->widget(), QString(), m_outputPlan, fieldNo);
+			continue;
+		}
+		QList<OutputStep> fieldPlan;
+		if (!addFormsOutputSteps(li->widget(), separator, fieldPlan))
+			continue;
+		if (hasValue)
+			addOutputLiteral(m_outputPlan, separator);
+		addOutputSteps(m_outputPlan, fieldPlan);
+		hasValue = true;
+	}
+
+	// --emit-changes: the fields, keyed as in the json output
+	if (m_changeInterval > -1) {
+		QList<OutputStep> changePlan;
+		int changeFieldNo = 0;
+		for (int i = 0; i < fl->count(); ++i) {
+			QLayoutItem* li = fl->itemAt(i, QFormLayout::FieldRole);
+			if (li)
+				addFormsFieldSteps(li->widget(), QString(), changePlan, changeFieldNo);
+		}
+		foreach (const OutputStep& step, changePlan) {
+			switch (step.kind) {
+			case OutputStep::Calendar:
+				connect(step.widget, SIGNAL(selectionChanged()), SLOT(fieldChanged()));
+				break;
+			case OutputStep::CheckBox:
+				connect(step.widget, SIGNAL(toggled(bool)), SLOT(fieldChanged()));
+				break;
+			case OutputStep::Combo:
+				connect(step.widget, SIGNAL(currentTextChanged(QString)), SLOT(fieldChanged()));
+				break;
+			case OutputStep::DoubleSpinBox:
+				connect(step.widget, SIGNAL(valueChanged(double)), SLOT(fieldChanged()));
+				break;
+			case OutputStep::LineEdit:
+				connect(step.widget, SIGNAL(textChanged(QString)), SLOT(fieldChanged()));
+				break;
+			case OutputStep::List:
+				connect(step.widget, SIGNAL(itemSelectionChanged()), SLOT(fieldChanged()));
+				connect(step.widget, SIGNAL(itemChanged(QTreeWidgetItem*, int)), SLOT(fieldChanged()));
+				break;
+			case OutputStep::Slider:
+			case OutputStep::SpinBox:
+				connect(step.widget, SIGNAL(valueChanged(int)), SLOT(fieldChanged()));
+				break;
+			case OutputStep::TextEdit:
+				connect(step.widget, SIGNAL(textChanged()), SLOT(fieldChanged()));
+				break;
+			default:
+				continue;
+			}
+			m_changeFields.insert(step.widget, step);
+		}
+		if (!m_changeTimer) {
+			m_changeTimer = new QTimer(this);
+			m_changeTimer->setSingleShot(true);
+			connect(m_changeTimer, SIGNAL(timeout()), SLOT(emitFieldChanges()));
+		}
+		m_changeClock.start();
+	}
+
 	if (noCancelButton)
 		btns->button(QDialogButtonBox::Cancel)->hide();
 
@@ -4760,14 +7408,14 @@ char Guid::showForms(const QStringList& args) {
 		QIcon menuActionIcon;
 
 		QAction* actionSysTrayMinimize = new QAction(tr("Minimize"), sysTrayIcon);
-		actionSysTrayMinimize->setProperty("guid_systray_menu_action", "Minimize");
+		editMeta(actionSysTrayMinimize).sysTrayMenuAction = "Minimize";
 		menuActionIcon = QApplication::style()->standardIcon(QStyle::SP_TitleBarMinButton);
 		actionSysTrayMinimize->setIcon(menuActionIcon);
 		connect(actionSysTrayMinimize, SIGNAL(triggered()), this, SLOT(minimizeDialog()));
 		sysTrayMenu->addAction(actionSysTrayMinimize);
 
 		QAction* actionSysTrayShow = new QAction(tr("Show"), sysTrayIcon);
-		actionSysTrayShow->setProperty("guid_systray_menu_action", "Show");
+		editMeta(actionSysTrayShow).sysTrayMenuAction = "Show";
 		menuActionIcon = QApplication::style()->standardIcon(QStyle::SP_TitleBarMaxButton);
 		actionSysTrayShow->setIcon(menuActionIcon);
 		connect(actionSysTrayShow, SIGNAL(triggered()), this, SLOT(showDialog()));
@@ -4776,7 +7424,7 @@ char Guid::showForms(const QStringList& args) {
 		sysTrayMenu->addSeparator();
 
 		QAction* actionSysTrayQuit = new QAction(tr("Quit"), sysTrayIcon);
-		actionSysTrayQuit->setProperty("guid_systray_menu_action", "Quit");
+		editMeta(actionSysTrayQuit).sysTrayMenuAction = "Quit";
 		menuActionIcon = QApplication::style()->standardIcon(QStyle::SP_DialogCloseButton);
 		actionSysTrayQuit->setIcon(menuActionIcon);
 		//connect(actionSysTrayQuit, SIGNAL(triggered()), qApp, SLOT(quit()));
@@ -4809,8 +7457,8 @@ char Guid::showList(const QStringList& args) {
 	tw->setAllColumnsShowFocus(true);
 	tw->setSizeAdjustPolicy(QAbstractScrollArea::AdjustToContents);
 	tw->header()->setStretchLastSection(true);
-	tw->setProperty("guid_list_print_column", "1");
-	tw->setProperty("guid_list_add_value", "");
+	editMeta(tw).listPrintColumn = "1";
+	editMeta(tw).listAddValue = "";
 
 	bool editable(false), exclusive(false), checkable(false), icons(false), ok, needFilter(true);
 	QString selectionType;
@@ -4818,13 +7466,13 @@ char Guid::showList(const QStringList& args) {
 	QStringList columns;
 	GList list = GList();
 	QList<int> hiddenCols;
-	dlg->setProperty("guid_separator", "|");
-	QFileSystemWatcher* listWatcher = new QFileSystemWatcher(dlg);
+	editMeta(dlg).separator = "|";
 
 	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--text")
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Text)
 			lbl->setText(labelText(NEXT_ARG));
-		else if (args.at(i) == "--align") {
+		else if (option == Option::Align) {
 			if (lbl) {
 				QString alignment = NEXT_ARG;
 				if (alignment == "left")
@@ -4837,39 +7485,43 @@ char Guid::showList(const QStringList& args) {
 					qOutErr << m_prefixErr + "argument --align: unknown value" << args.at(i) << Qt::endl;
 			} else
 				WARN_UNKNOWN_ARG("--text");
-		} else if (args.at(i) == "--multiple") {
+		} else if (option == Option::Multiple) {
 			tw->setSelectionMode(QAbstractItemView::ExtendedSelection);
-		} else if (args.at(i) == "--no-selection") {
+		} else if (option == Option::NoSelection) {
 			tw->setSelectionMode(QAbstractItemView::NoSelection);
 			tw->setFocusPolicy(Qt::NoFocus);
-		} else if (args.at(i) == "--column") {
+		} else if (option == Option::Column) {
 			columns << NEXT_ARG;
-		} else if (args.at(i) == "--editable")
+		} else if (option == Option::Editable)
 			editable = true;
-		else if (args.at(i) == "--hide-header")
+		else if (option == Option::HideHeader)
 			tw->setHeaderHidden(true);
-		else if (args.at(i) == "--separator")
-			dlg->setProperty("guid_separator", NEXT_ARG);
-		else if (args.at(i) == "--hide-column") {
+		else if (option == Option::Separator)
+			editMeta(dlg).separator = NEXT_ARG;
+		else if (option == Option::OutputFormat) {
+			const QString format = NEXT_ARG;
+			if (!outputFormatFromName(format, editMeta(dlg).outputFormat))
+				qOutErr << m_prefixErr + "argument --output-format: unknown value" << format << Qt::endl;
+		} else if (option == Option::HideColumn) {
 			int v = NEXT_ARG.toInt(&ok);
 			if (ok)
 				hiddenCols << v - 1;
-		} else if (args.at(i) == "--print-column") {
-			tw->setProperty("guid_list_print_column", NEXT_ARG.toLower());
-		} else if (args.at(i) == "--checklist") {
+		} else if (option == Option::PrintColumn) {
+			editMeta(tw).listPrintColumn = NEXT_ARG.toLower();
+		} else if (option == Option::Checklist) {
 			tw->setSelectionMode(QAbstractItemView::NoSelection);
 			tw->setAllColumnsShowFocus(false);
 			selectionType = "checklist";
 			checkable = true;
-		} else if (args.at(i) == "--radiolist") {
+		} else if (option == Option::Radiolist) {
 			tw->setSelectionMode(QAbstractItemView::NoSelection);
 			tw->setAllColumnsShowFocus(false);
 			selectionType = "radiolist";
 			checkable = true;
 			exclusive = true;
-		} else if (args.at(i) == "--imagelist") {
+		} else if (option == Option::Imagelist) {
 			icons = true;
-		} else if (args.at(i) == "--mid-search") {
+		} else if (option == Option::MidSearch) {
 			if (needFilter) {
 				needFilter = false;
 				QLineEdit* filter;
@@ -4880,33 +7532,32 @@ char Guid::showList(const QStringList& args) {
 						tw->topLevelItem(i)->setHidden(!tw->topLevelItem(i)->text(0).contains(match, Qt::CaseInsensitive));
 				});
 			}
-		} else if (args.at(i) == "--field-height") {
+		} else if (option == Option::FieldHeight) {
 			heightToSet = NEXT_ARG.toInt(&ok);
 			if (!ok)
 				heightToSet = -1;
-		} else if (args.at(i) == "--list-values-from-file") {
+		} else if (option == Option::ListValuesFromFile) {
 			list = listValuesFromFile(NEXT_ARG);
 
-			tw->setProperty("guid_list_add_value", list.addValue);
-			tw->setProperty("guid_file_sep", list.fileSep);
-			tw->setProperty("guid_file_path", list.filePath);
-			tw->setProperty("guid_monitor_file", list.monitorFile);
+			WidgetMeta& listMeta = editMeta(tw);
+			listMeta.listAddValue = list.addValue;
+			listMeta.fileSep = list.fileSep;
+			listMeta.monitorFile = list.monitorFile;
 
-			if (QFile::exists(list.filePath)) {
-				listWatcher->addPath(list.filePath);
-				connect(listWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateList(QString)), Qt::UniqueConnection);
+			if (list.monitorFile && QFile::exists(list.filePath)) {
+				watchFile(list.filePath, tw, WatchList, list.pollInterval);
 			}
-		} else if (args.at(i) == "--print-values") {
-			tw->setProperty("guid_list_print_values_mode", NEXT_ARG.toLower());
-		} else if (args.at(i) != "--list") {
+		} else if (option == Option::PrintValues) {
+			editMeta(tw).listPrintValuesMode = NEXT_ARG.toLower();
+		} else if (option != Option::List) {
 			list.val << args.at(i);
 		}
 	}
 	if (list.val.isEmpty())
 		listenToStdIn();
 
-	tw->setProperty("guid_list_selection_type", selectionType);
-	tw->setProperty("guid_list_flags", int(editable | checkable << 1 | icons << 2));
+	editMeta(tw).listSelectionType = selectionType;
+	editMeta(tw).listFlags = int(editable | checkable << 1 | icons << 2);
 
 	int columnCount = qMax(columns.count(), 1);
 	tw->setColumnCount(columnCount);
@@ -4924,8 +7575,11 @@ char Guid::showList(const QStringList& args) {
 	for (int i = 0; i < columns.count(); ++i)
 		tw->resizeColumnToContents(i);
 
-	if (!selectionType.isEmpty())
+	tw->setUniformRowHeights(true);
+	if (!selectionType.isEmpty()) {
+		tw->setItemDelegateForColumn(0, new SelectionColumn(selectionType == "radiolist", tw));
 		tw->header()->setSectionResizeMode(0, QHeaderView::Fixed);
+	}
 
 	if (heightToSet >= 0 && heightToSet < getQTreeWidgetSize(&tw).height())
 		tw->setMaximumHeight(heightToSet);
@@ -4944,19 +7598,20 @@ char Guid::showMessage(const QStringList& args, char type) {
 
 	bool wrap = true, html = true;
 	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--text")
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Text)
 			dlg->setText(html ? labelText(NEXT_ARG) : NEXT_ARG);
-		else if (args.at(i) == "--icon-name")
+		else if (option == Option::IconName)
 			dlg->setIconPixmap(QIcon(NEXT_ARG).pixmap(64));
-		else if (args.at(i) == "--no-wrap")
+		else if (option == Option::NoWrap)
 			wrap = false;
-		else if (args.at(i) == "--ellipsize")
+		else if (option == Option::Ellipsize)
 			wrap = true;
-		else if (args.at(i) == "--no-markup")
+		else if (option == Option::NoMarkup)
 			html = false;
-		else if (args.at(i) == "--default-cancel")
+		else if (option == Option::DefaultCancel)
 			dlg->setDefaultButton(QMessageBox::Cancel);
-		else if (args.at(i) == "--selectable-labels")
+		else if (option == Option::SelectableLabels)
 			m_selectableLabel = true;
 		else if (args.at(i).startsWith("--") && args.at(i) != "--info" && args.at(i) != "--question" && args.at(i) != "--warning" && args.at(i) != "--error")
 			qOutErr << m_prefixErr + "unspecific argument" << args.at(i) << Qt::endl;
@@ -4977,14 +7632,15 @@ char Guid::showNotification(const QStringList& args) {
 	QString message;
 	bool listening(false);
 	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--text") {
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Text) {
 			message = NEXT_ARG;
-		} else if (args.at(i) == "--listen") {
+		} else if (option == Option::Listen) {
 			listening = true;
 			listenToStdIn();
-		} else if (args.at(i) == "--hint") {
+		} else if (option == Option::Hint) {
 			m_notificationHints = NEXT_ARG;
-		} else if (args.at(i) == "--selectable-labels") {
+		} else if (option == Option::SelectableLabels) {
 			m_selectableLabel = true;
 		} else {
 			WARN_UNKNOWN_ARG("--notification")
@@ -5003,12 +7659,13 @@ char Guid::showPassword(const QStringList& args) {
 	QLineEdit *username(NULL), *password(NULL);
 	QString prompt = tr("Enter password");
 	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--username") {
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Username) {
 			tll->addWidget(new QLabel(tr("Enter username"), dlg));
 			tll->addWidget(username = new QLineEdit(dlg));
 			username->setObjectName("guid_username");
 			break;
-		} else if (args.at(i) == "--prompt") {
+		} else if (option == Option::Prompt) {
 			prompt = NEXT_ARG;
 		}
 		{ WARN_UNKNOWN_ARG("--password") }
@@ -5035,21 +7692,22 @@ char Guid::showProgress(const QStringList& args) {
 	QProgressDialog* dlg = new QProgressDialog;
 	dlg->setRange(0, 101);
 	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--text")
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Text)
 			dlg->setLabelText(labelText(NEXT_ARG));
-		else if (args.at(i) == "--percentage")
+		else if (option == Option::Percentage)
 			dlg->setValue(NEXT_ARG.toUInt());
-		else if (args.at(i) == "--pulsate")
+		else if (option == Option::Pulsate)
 			dlg->setRange(0, 0);
-		else if (args.at(i) == "--auto-close")
-			dlg->setProperty("guid_autoclose", true);
-		else if (args.at(i) == "--auto-kill")
-			dlg->setProperty("guid_autokill_parent", true);
-		else if (args.at(i) == "--no-cancel") {
+		else if (option == Option::AutoClose)
+			editMeta(dlg).autoClose = true;
+		else if (option == Option::AutoKill)
+			editMeta(dlg).autoKillParent = true;
+		else if (option == Option::NoCancel) {
 			if (QPushButton* btn = dlg->findChild<QPushButton*>())
 				btn->hide();
-		} else if (args.at(i) == "--time-remaining") {
-			dlg->setProperty("guid_eta", true);
+		} else if (option == Option::TimeRemaining) {
+			editMeta(dlg).eta = true;
 		} else {
 			WARN_UNKNOWN_ARG("--progress")
 		}
@@ -5067,6 +7725,49 @@ char Guid::showProgress(const QStringList& args) {
 	return 0;
 }
 
+char Guid::showMultiProgress(const QStringList& args) {
+	NEW_DIALOG
+
+	QLabel* label = new QLabel(dlg);
+	label->setVisible(false);
+	tll->addWidget(label);
+
+	QTreeWidget* tw = new QTreeWidget(dlg);
+	tw->setRootIsDecorated(false);
+	tw->setUniformRowHeights(true);
+	tw->setSelectionMode(QAbstractItemView::NoSelection);
+	tw->setHeaderLabels(QStringList() << tr("Job") << tr("Status") << tr("Progress") << tr("Rate") << tr("Time remaining"));
+	tw->setItemDelegateForColumn(2, new ProgressColumn(tw));
+	tw->header()->setStretchLastSection(false);
+	tw->header()->setSectionResizeMode(1, QHeaderView::Stretch);
+	tw->header()->resizeSection(2, 160);
+	tw->setMinimumWidth(560);
+	tll->addWidget(tw);
+
+	bool noCancel = false;
+	for (int i = 0; i < args.count(); ++i) {
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Text) {
+			label->setText(labelText(NEXT_ARG));
+			label->setVisible(true);
+		} else if (option == Option::AutoClose) {
+			editMeta(dlg).autoClose = true;
+		} else if (option == Option::NoCancel) {
+			noCancel = true;
+		} else {
+			WARN_UNKNOWN_ARG("--multi-progress")
+		}
+	}
+
+	FINISH_DIALOG(QDialogButtonBox::Cancel)
+	if (noCancel)
+		btns->button(QDialogButtonBox::Cancel)->hide();
+
+	listenToStdIn();
+	SHOW_DIALOG
+	return 0;
+}
+
 char Guid::showScale(const QStringList& args) {
 	QOUT_ERR
 	NEW_DIALOG
@@ -5088,9 +7789,10 @@ char Guid::showScale(const QStringList& args) {
 
 	bool ok;
 	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--text")
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Text)
 			lbl->setText(labelText(NEXT_ARG));
-		else if (args.at(i) == "--align") {
+		else if (option == Option::Align) {
 			if (lbl) {
 				QString alignment = NEXT_ARG;
 				if (alignment == "left")
@@ -5103,23 +7805,23 @@ char Guid::showScale(const QStringList& args) {
 					qOutErr << m_prefixErr + "argument --align: unknown value" << args.at(i) << Qt::endl;
 			} else
 				WARN_UNKNOWN_ARG("--text");
-		} else if (args.at(i) == "--value")
+		} else if (option == Option::Value)
 			sld->setValue(NEXT_ARG.toInt());
-		else if (args.at(i) == "--min-value") {
+		else if (option == Option::MinValue) {
 			int v = NEXT_ARG.toInt(&ok);
 			if (ok)
 				sld->setMinimum(v);
-		} else if (args.at(i) == "--max-value") {
+		} else if (option == Option::MaxValue) {
 			int v = NEXT_ARG.toInt(&ok);
 			if (ok)
 				sld->setMaximum(v);
-		} else if (args.at(i) == "--step") {
+		} else if (option == Option::Step) {
 			int u = NEXT_ARG.toInt(&ok);
 			if (ok)
 				sld->setSingleStep(u);
-		} else if (args.at(i) == "--print-partial") {
+		} else if (option == Option::PrintPartial) {
 			connect(sld, SIGNAL(valueChanged(int)), SLOT(printInteger(int)));
-		} else if (args.at(i) == "--hide-value") {
+		} else if (option == Option::HideValue) {
 			val->hide();
 		} else {
 			WARN_UNKNOWN_ARG("--scale")
@@ -5142,27 +7844,33 @@ char Guid::showText(const QStringList& args) {
 	QString curlPath;
 	bool html(false), plain(false), onlyMarkup(false), url(false);
 	for (int i = 0; i < args.count(); ++i) {
-		if (args.at(i) == "--filename") {
+		const Option option = optionFromArg(args.at(i));
+		if (option == Option::Filename) {
 			filename = NEXT_ARG;
-		} else if (args.at(i) == "--url") {
+		} else if (option == Option::Url) {
 			filename = NEXT_ARG;
 			url = true;
-		} else if (args.at(i) == "--curl-path") {
+		} else if (option == Option::CurlPath) {
 			curlPath = NEXT_ARG;
-		} else if (args.at(i) == "--editable") {
+		} else if (option == Option::Editable) {
 			te->setReadOnly(false);
-		} else if (args.at(i) == "--font") {
+		} else if (option == Option::Font) {
 			te->setFont(QFont(NEXT_ARG));
-		} else if (args.at(i) == "--checkbox") {
+		} else if (option == Option::Checkbox) {
 			tll->addWidget(cb = new QCheckBox(NEXT_ARG, dlg));
-		} else if (args.at(i) == "--auto-scroll") {
-			te->setProperty("guid_autoscroll", true);
-		} else if (args.at(i) == "--html") {
+		} else if (option == Option::AutoScroll) {
+			editMeta(te).autoScroll = true;
+		} else if (option == Option::MaxLines) {
+			bool ok;
+			const int maxLines = NEXT_ARG.toInt(&ok);
+			if (ok && maxLines > 0)
+				te->document()->setMaximumBlockCount(maxLines); // the oldest lines are dropped
+		} else if (option == Option::Html) {
 			html = true;
-			te->setProperty("guid_html", true);
-		} else if (args.at(i) == "--plain") {
+			editMeta(te).html = true;
+		} else if (option == Option::Plain) {
 			plain = true;
-		} else if (args.at(i) == "--no-interaction") {
+		} else if (option == Option::NoInteraction) {
 			onlyMarkup = true;
 		} else {
 			WARN_UNKNOWN_ARG("--text-info");
@@ -5189,6 +7897,7 @@ char Guid::showText(const QStringList& args) {
 	}
 
 	if (filename.isNull()) {
+		te->setUndoRedoEnabled(false); // the undo stack would keep a copy of the whole stream
 		listenToStdIn();
 	} else if (url) {
 		QProcess* curl = new QProcess;
@@ -5230,6 +7939,7 @@ char Guid::showText(const QStringList& args) {
  * main
  ******************************************************************************/
 
+#ifndef GUID_NO_MAIN // tests/tst_guid.cpp has its own
 int main(int argc, char** argv) {
 	if (argc < 2) {
 		Guid::printHelp();
@@ -5263,6 +7973,23 @@ int main(int argc, char** argv) {
 		}
 	}
 
+#ifdef Q_OS_UNIX
+	if (!strcmp(argv[1], "--client") || !strncmp(argv[1], "--client=", 9)) {
+		const int exitCode = runClient(argc, argv);
+		if (exitCode > -1)
+			return exitCode;
+
+		// No server is listening: show the dialog ourselves
+		argv[1] = argv[0];
+		++argv;
+		--argc;
+		if (argc < 2) {
+			Guid::printHelp();
+			return 1;
+		}
+	}
+#endif
+
 	QFont appFont("Sans-serif", 12);
 	QApplication::setFont(appFont);
 	foreach (QWidget* widget, QApplication::allWidgets()) {
@@ -5274,6 +8001,7 @@ int main(int argc, char** argv) {
 
 	return d.exec();
 }
+#endif
 
 // End of "main"
 
@@ -20,14 +20,32 @@
 #pragma once
 
 #include <QApplication>
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QElapsedTimer>
 #include <QGroupBox>
+#include <QHash>
 #include <QLabel>
+#include <QMap>
 #include <QPair>
+#include <QPointer>
+#include <QSet>
+#include <QSharedPointer>
 #include <QSystemTrayIcon>
 #include <QTreeWidget>
 #include <QWidget>
 
+#include <cfloat>
+#include <climits>
+
+class QComboBox;
 class QDialog;
+class QFileSystemWatcher;
+class QProcess;
+class QPropertyAnimation;
+class QSocketNotifier;
+class QTextEdit;
+class QTimer;
 class QTreeWidgetItem;
 
 struct GList {
@@ -35,15 +53,203 @@ struct GList {
 	QString filePath;
 	QString fileSep;
 	bool monitorFile;
+	int pollInterval;
 	QStringList val;
 };
 
+// Entry of the --form-cache directory: what building a form reads from disk
+struct FormCache {
+	QStringList args; // after --forms-spec expansion
+	QHash<QString, QPair<qint64, qint64>> files; // modification time (ms) and size of each file read
+	bool loaded = false; // true when the entry was read back from the cache
+	QHash<QString, QStringList> values; // list values by "file path\nseparator"
+};
+
 struct FormsSettings {
 	bool hasLabel = false;
 	bool hasTopMenu = false;
 	bool hasHeader = false;
 };
 
+// File of the monitorMarkerFileN markers, parsed once per change
+struct MarkerSource {
+	QString content; // without the trailing line breaks
+	qint64 modified = -1; // modification time (ms)
+	qint64 size = -1;
+	QHash<QString, QString> vars; // value of each "name=value" line
+};
+
+// --output-format
+enum class OutputFormat {Text, Json, Nul, Shell};
+
+// Step of what a form prints: a literal, or a field whose value is read when printing.
+// The json, nul and shell plans have no literals: each field is keyed, and tabs and
+// groups are objects.
+struct OutputStep {
+	enum Kind {
+		Literal,
+		Calendar,
+		CheckBox,
+		Combo,
+		DoubleSpinBox,
+		LineEdit,
+		List,
+		ObjectEnd,
+		ObjectStart,
+		Slider,
+		SpinBox,
+		TabEnd,
+		TabStart,
+		TextEdit
+	};
+	Kind kind = Literal;
+	QString text; // Literal; key of a field or an ObjectStart
+	const QWidget* widget = NULL;
+	int index = -1; // TabStart and TabEnd
+};
+
+// Command of --action-after-ok-click or of a menu item, run by the job executor
+struct Job {
+	enum Output {
+		NoOutput, // forwarded to stdout and stderr
+		FooterOutput,
+		MenuOutput // ends the MENU_CLICKED_DATA line
+	};
+	QStringList args;
+	QPointer<QGroupBox> footer; // FooterOutput
+	Output output = NoOutput;
+	QString program;
+	qint64 queued = 0; // m_jobClock time (ms)
+	qint64 started = 0;
+};
+
+// --job-policy: what a job started while --max-jobs are running does
+enum class JobPolicy {Queue, Drop, Replace};
+
+// --stats
+struct JobStats {
+	int dropped = 0;
+	int finished = 0;
+	int killed = 0;
+	int maxQueued = 0;
+	int replaced = 0;
+	qint64 runMax = 0; // ms
+	qint64 runTotal = 0;
+	int started = 0;
+	int timedOut = 0;
+	qint64 waitMax = 0; // ms, in the queue
+	qint64 waitTotal = 0;
+};
+
+// Latest label and value of a --multi-progress job, not shown yet
+struct ProgressUpdate {
+	QString job;
+	QString label; // null: unchanged
+	int value = -1; // -1: unchanged
+};
+
+// Marker N of a --add-text label (monitorMarkerFileN, monitorVarNameN, defMarkerValN)
+struct WidgetMarker {
+	QString defVal;
+	QString file;
+	QString varName;
+};
+
+// Markers by number, as many as the widget settings define
+typedef QMap<int, WidgetMarker> WidgetMarkers;
+
+// Size, modification time and content hash of a monitored list file. The size and time
+// tell that nothing changed without reading the file; the hash tells a touch from an edit.
+struct FileSignature {
+	QByteArray hash; // MD5, null: not read yet
+	qint64 modified = -1; // ms
+	qint64 size = -1;
+};
+Q_DECLARE_METATYPE(FileSignature)
+Q_DECLARE_METATYPE(QSharedPointer<QAtomicInt>)
+
+// Guid settings of a dialog, widget or action, looked up with meta() and set with editMeta()
+struct WidgetMeta {
+	enum Container {NoContainer, ColumnsContainer, FileSelContainer, ListContainer, ScaleContainer};
+
+	// Any widget
+	Container container = NoContainer;
+	bool hide = false;
+	QString var;
+
+	// Dialog
+	bool autoClose = false;
+	bool autoKillParent = false;
+	QString dateFormat; // null: locale format
+	bool eta = false;
+	QString fontPattern;
+	QString listRowSeparator;
+	OutputFormat outputFormat = OutputFormat::Text;
+	QHash<QString, QTreeWidgetItem*> progressRows; // of --multi-progress, by job
+	QString separator;
+
+	// Monitored combo and list values
+	QString fileSep;
+	bool monitorFile = false;
+
+	// Forms defaults, restored by --ok-clear
+	bool checkboxDefault = false;
+	int comboDefaultIndex = -1;
+	double doubleSpinBoxDefault = -DBL_MAX; // -DBL_MAX: none
+	int scaleDefault = INT_MIN; // INT_MIN: none
+	int spinBoxDefault = INT_MIN; // INT_MIN: none
+
+	// File selection
+	QString fileSelSeparator;
+
+	// List
+	QString listAddValue;
+	bool listExcludeFromOutput = false;
+	int listFlags = 0; // editable, checkable and icons bits of addItems()
+	QString listPrintColumn;
+	QString listPrintValuesMode;
+	int listReadOnlyColumn = -1;
+	QString listSelectionType;
+	FileSignature listSignature; // of the monitored file when last read
+
+	// Tabs
+	bool tabBarVerbose = false;
+	bool tabDisableButtons = false;
+
+	// Text and text info
+	bool follow = false; // also for the footer
+	qint64 followFileId = -1;
+	qint64 followOffset = -1;
+	qint64 followSize = -1; // at the previous read
+	QString textContent;
+	QString textCurlPath;
+	QString textFilename;
+	QString textFormat;
+	int textHeight = -1;
+	QString textInfoNsep;
+	bool textIsUrl = false;
+	QMap<int, QString> textMarkerValues; // set with --control
+	WidgetMarkers textMarkers;
+	bool textMarkersSet = false;
+	bool textReadOnly = false;
+
+	// Footer
+	int footerNbEntries = 3;
+
+	// Menu item
+	QString menuItemCommand;
+	bool menuItemCommandPrintOutput = false;
+	int menuItemExitCode = 0;
+	QString menuItemName;
+
+	// System tray action
+	QString sysTrayMenuAction;
+
+	// --text-info read from stdin
+	bool autoScroll = false;
+	bool html = false;
+};
+
 struct WidgetSettings {
 	QString addLabel = "";
 	bool addNewRowButton = false;
@@ -53,40 +259,16 @@ struct WidgetSettings {
 	QString command = "";
 	bool commandToFooter = false;
 	int defaultIndex = 0;
-	QString defMarkerVal1 = "";
-	QString defMarkerVal2 = "";
-	QString defMarkerVal3 = "";
-	QString defMarkerVal4 = "";
-	QString defMarkerVal5 = "";
-	QString defMarkerVal6 = "";
-	QString defMarkerVal7 = "";
-	QString defMarkerVal8 = "";
-	QString defMarkerVal9 = "";
 	bool disableButtons = false;
 	bool excludeFromOutput = false;
+	bool follow = false;
 	QString foregroundColor = "";
 	bool hideLabel = false;
 	QString image = "";
 	bool keepOpen = false;
+	WidgetMarkers markers;
 	bool monitorFile = false;
-	QString monitorMarkerFile1 = "";
-	QString monitorMarkerFile2 = "";
-	QString monitorMarkerFile3 = "";
-	QString monitorMarkerFile4 = "";
-	QString monitorMarkerFile5 = "";
-	QString monitorMarkerFile6 = "";
-	QString monitorMarkerFile7 = "";
-	QString monitorMarkerFile8 = "";
-	QString monitorMarkerFile9 = "";
-	QString monitorVarName1 = "";
-	QString monitorVarName2 = "";
-	QString monitorVarName3 = "";
-	QString monitorVarName4 = "";
-	QString monitorVarName5 = "";
-	QString monitorVarName6 = "";
-	QString monitorVarName7 = "";
-	QString monitorVarName8 = "";
-	QString monitorVarName9 = "";
+	int poll = 0;
 	bool selected = false;
 	QString sep = "";
 	int size = 0;
@@ -117,7 +299,8 @@ public:
 		ColorSelection,
 		FontSelection,
 		Password,
-		Forms
+		Forms,
+		MultiProgress
 	};
 	static void printHelp(const QString& category = QString());
 	using QApplication::notify;
@@ -131,10 +314,42 @@ private:
 	void notify(const QString message, bool noClose = false);
 	QString printForms();
 	bool readGeneral(QStringList& args);
+	void resetSession();
+	void run(QStringList argList);
 	void setSysTrayAction(QString actionId, bool valueToSet);
-	void updateFooterContent(QGroupBox* footer, QString newEntry);
+	void updateFooterContent(QGroupBox* footer, QString newEntry, bool fromControl = false);
 	void updateFooterContentFromFile(QGroupBox* footer, QString filePath);
 
+	// File watching
+	enum FileWatchKind {
+		WatchCombo,
+		WatchFooter,
+		WatchList,
+		WatchText,
+		WatchTextInfo
+	};
+	typedef QPair<QWidget*, FileWatchKind> FileSubscriber;
+	void parseFile(QWidget* widget, const QString& filePath, const QString& fileSep);
+	void runControlCommands(const QByteArray& input);
+	void startInputFlush();
+	void updateCombo(QComboBox* combo, const QStringList& values);
+	void updateList(QTreeWidget* tw, const QStringList& values);
+	void updateListRows();
+	void updateMultiProgress();
+	void updateProgress();
+	void updateTextInfo();
+	void watchFile(const QString& filePath, QWidget* widget, FileWatchKind kind, int pollInterval = 0);
+
+	// Job executor
+	void finishJob(QProcess* process);
+	void queueJob(Job job);
+	void runJob(Job job);
+	void stopJobs();
+
+	// Server mode
+	void finishSession(int exitCode);
+	bool startServer(const QString& socketPath);
+
 	// Show dialogs
 	char showCalendar(const QStringList& args);
 	char showColorSelection(const QStringList& args);
@@ -144,6 +359,7 @@ private:
 	char showForms(const QStringList& args);
 	char showList(const QStringList& args);
 	char showMessage(const QStringList& args, char type);
+	char showMultiProgress(const QStringList& args);
 	char showNotification(const QStringList& args);
 	char showPassword(const QStringList& args);
 	char showProgress(const QStringList& args);
@@ -156,31 +372,60 @@ private slots:
 	void afterCloseButtonClick();
 	void afterMenuClick();
 	void dialogFinished(int status);
+	void directoryChanged(const QString& dirPath);
+	void dispatchFileChanges();
+	void emitFieldChanges();
 	void exitGuid(int exitCode = 0, bool minimize = false);
+	void fieldChanged();
+	void fileChanged(const QString& filePath);
+	void fileParsed(QObject* widget, QSharedPointer<QAtomicInt> latest, int generation, const FileSignature& signature, bool changed, const QStringList& values);
+	void filesPolled(const QStringList& changedFiles);
 	void finishProgress();
+	void flushInput();
 	void listMenu(const QPoint& pos);
 	void minimizeDialog();
+	void pollFiles();
 	void printFormsAfterOKClick();
 	void printInteger(int v);
 	void quitDialog();
 	void readStdIn();
+	void serverAccept();
+	void serverClientClosed();
 	void showDialog();
 	void showSysTrayMenu(QSystemTrayIcon::ActivationReason reason);
 	void toggleItems(QTreeWidgetItem* item, int column);
-	void updateCombo(QString filePath);
-	void updateFooter(QString filePath);
-	void updateList(QString filePath);
-	void updateText(QString filePath);
-	void updateTextInfo(QString filePath);
+	void unwatchFiles(QObject* widget);
+	void writeFieldChanges();
 
 private:
 	bool m_alwaysOnTop;
+	QString m_cachedText;
 	QString m_cancel;
 	QString m_caption;
+	QElapsedTimer m_changeClock;
+	QByteArray m_changeEvents; // --emit-changes output not written yet
+	QHash<const QObject*, OutputStep> m_changeFields; // keyed as in the json output
+	int m_changeInterval; // --emit-changes debounce (ms), -1: no events
+	QSocketNotifier* m_changeNotifier; // stdout writable again
+	QTimer* m_changeTimer;
+	QHash<const QObject*, qint64> m_changeTimes; // time of the last change not emitted yet
 	bool m_closeToSysTray;
 	QDialog* m_dialog;
+	QSet<QString> m_changedFiles;
+	QElapsedTimer m_fileBurstTime;
+	QTimer* m_fileDispatchTimer;
+	QHash<QString, QList<FileSubscriber>> m_fileSubscribers;
+	QFileSystemWatcher* m_fileWatcher;
 	bool m_helpMission;
 	QString m_icon;
+	QTimer* m_inputFlushTimer;
+	QElapsedTimer m_jobClock;
+	JobPolicy m_jobPolicy;
+	QList<Job> m_jobQueue;
+	JobStats m_jobStats;
+	int m_jobTimeout; // s, 0: none
+	bool m_killJobsOnExit;
+	int m_maxJobs; // 0: no limit
 	bool m_modal;
 	bool m_noTaskbar;
 	QString m_notificationHints;
@@ -190,15 +435,39 @@ private:
 	bool m_okCommandToFooter;
 	bool m_okKeepOpen;
 	bool m_okValuesToFooter;
+	QList<OutputStep> m_outputPlan; // see printForms()
 	int m_parentWindow;
+	QHash<QObject*, QSharedPointer<QAtomicInt>> m_parseGenerations;
+	QByteArray m_pendingInput; // stdin input not shown yet
+	QList<ProgressUpdate> m_pendingJobs;
+	QString m_pendingLabel;
+	int m_pendingValue;
+	int m_pollInterval;
+	bool m_pollRunning;
+	QSharedPointer<QHash<QString, QPair<qint64, qint64>>> m_pollStamps;
+	QTimer* m_pollTimer;
+	QHash<QString, QPair<int, qint64>> m_polledFiles; // interval and next check time (ms)
 	QString m_prefixErr;
 	QString m_prefixOk;
+	QDateTime m_progressStartTime;
+	QList<const QObject*> m_readyChanges; // debounced, waiting for stdout
+	QHash<QProcess*, Job> m_runningJobs;
+	QPropertyAnimation* m_scrollAnimator;
 	bool m_selectableLabel;
+	int m_serverFd;
+	QSocketNotifier* m_serverNotifier;
+	int m_serverStdFds[3];
+	int m_sessionFd;
+	QSocketNotifier* m_sessionNotifier;
 	QSize m_size;
+	bool m_stats;
 	QSystemTrayIcon* m_sysTray;
 	bool m_sysTrayMsg;
 	int m_timeout;
+	QTimer* m_timeoutTimer;
 	Type m_type;
+	QHash<QString, QStringList> m_watchedDirs;
+	QHash<QObject*, QStringList> m_watchedFiles;
 	bool m_zenity;
 };
 
@@ -94,6 +94,11 @@ Help("", "") <<
 
 Help("--timeout=TIMEOUT",
      QObject::tr("Set dialog timeout in seconds")) <<
+Help("--poll-interval=MS",
+     QObject::tr(R"HEREDOC(Also check monitored files for changes every MS milliseconds (at least 100).
+Use it for files on a network filesystem, whose changes made by other hosts are
+not notified. A file setting can give its own interval with "poll=MS", which also
+turns monitoring on.)HEREDOC")) <<
 Help("--always-on-top",
      QObject::tr("Force the dialog to be always on top of other windows")) <<
 Help("--no-taskbar",
@@ -105,7 +110,27 @@ Help("--modal",
 Help("--output-prefix-ok=PREFIX",
      QObject::tr("Set prefix for output sent to stdout")) <<
 Help("--output-prefix-err=PREFIX",
-     QObject::tr("Set prefix for output sent to stderr")));
+     QObject::tr("Set prefix for output sent to stderr")) <<
+Help("", "") <<
+
+Help("--max-jobs=N",
+     QObject::tr(R"HEREDOC(Run at most N commands of "--action-after-ok-click" and menu items at once
+(default is 4, 0 for no limit))HEREDOC")) <<
+Help("--job-policy=queue|drop|replace",
+     QObject::tr(R"HEREDOC(What a command started while "--max-jobs" commands are running does: wait
+its turn (default), be dropped, or replace the commands waiting)HEREDOC")) <<
+Help("--job-timeout=TIMEOUT",
+     QObject::tr("Kill commands still running after TIMEOUT seconds")) <<
+Help("--kill-jobs-on-exit",
+     QObject::tr(R"HEREDOC(Kill the commands still running when the dialog exits. By default, they
+keep running, and those waiting their turn without output to show are started.
+Commands whose output the dialog shows are always killed. The command of
+"--action-after-ok-click" closing the dialog is started on its own and never
+killed.)HEREDOC")) <<
+Help("--stats",
+     QObject::tr(R"HEREDOC(Print command statistics to stderr on exit: commands started, finished,
+dropped, replaced, timed out and killed, the longest queue, and the average and
+longest times waited in the queue and run (ms))HEREDOC")));
 
 /******************************
  * application
@@ -116,6 +141,18 @@ Help("--display=DISPLAY",
      QObject::tr("X display to use")) <<
 Help("", "") <<
 
+Help("--server=SOCKET",
+     QObject::tr("Keep running and show the dialogs requested by guid clients (Unix only).\n"
+                 "SOCKET is optional and defaults to $GUID_SERVER_SOCKET, then to\n"
+                 "$XDG_RUNTIME_DIR/guid-server-UID.sock. Only clients of the same user are\n"
+                 "served")) <<
+Help("--client=SOCKET",
+     QObject::tr("Must be the first option. Ask the guid server listening on SOCKET to show\n"
+                 "the dialog described by the other options, using this process's stdin,\n"
+                 "stdout, stderr and exit code. SOCKET is optional (see --server). If no\n"
+                 "server is listening, the dialog is shown by this process")) <<
+Help("", "") <<
+
 Help("--calendar",
      QObject::tr("Display calendar dialog")) <<
 Help("--color-selection",
@@ -134,6 +171,11 @@ Help("--info",
      QObject::tr("Display info dialog")) <<
 Help("--list",
      QObject::tr("Display list dialog")) <<
+Help("--multi-progress",
+     QObject::tr(R"HEREDOC(Display one progress bar per job, read from stdin as "job:percentage" and
+"job:#label" lines. A row is added when a job first appears, with its rate
+and time remaining. Options: --text, --auto-close and --no-cancel. Example:
+{ echo "worker1:#Downloading"; echo "worker1:42"; echo "worker2:10"; } | guid --multi-progress)HEREDOC")) <<
 Help("--notification",
      QObject::tr("Display notification")) <<
 Help("--password",
@@ -303,6 +345,45 @@ guid --forms \
 The list of variables supported is displayed at the beginning of each widget section.)HEREDOC"), "") <<
 Help("", "") <<
 
+// --forms-spec
+Help("--forms-spec=FILE",
+     QObject::tr(R"HEREDOC(Read the form from a JSON spec file instead of the command line ("-" for stdin).
+The spec is an array of options in command line order. Each item is an option name,
+or an object whose members are options with their value:
+- true adds the option without value (false and null are ignored)
+- a string or a number is the option value
+- an array is a list of values joined with "|"
+- an object holds the widget variables, and the label in the "text" member
+--forms is implied. Options given on the command line are kept. Example:
+guid --forms-spec=profile.json
+with profile.json:
+[
+ {"title": "Profile"},
+ {"add-entry": "Your name"},
+ {"add-combo": "Country", "combo-values": ["Canada", "France"]},
+ {"add-file-selection": {"buttonText": "Select file", "text": "Your document"}},
+ "no-cancel"
+])HEREDOC")) <<
+Help("--form-cache=DIR",
+     QObject::tr(R"HEREDOC(Keep in DIR what the form reads from disk (expanded --forms-spec options and
+values from files), keyed by the command line. A later launch with the same options
+reuses it as long as none of the files read has changed.)HEREDOC")) <<
+Help("--control=stdin",
+     QObject::tr(R"HEREDOC(Read commands from stdin while the form is displayed, one JSON object per line.
+The field is given by its "--var" name. The commands read at once are applied
+together, with a single repaint:
+{"cmd": "set", "var": "NAME", "value": "Value"}
+{"cmd": "add-rows", "var": "NAME", "rows": [["Cell 1", "Cell 2"], ["Cell 1", "Cell 2"]]}
+{"cmd": "remove-rows", "var": "NAME", "rows": [0, 2]} (or "all": true)
+{"cmd": "marker", "var": "NAME", "marker": 1, "value": "Value"}
+{"cmd": "footer", "entries": ["Entry", "Newer entry"]}
+{"cmd": "enable", "var": "NAME"} (or "disable")
+"marker" replaces GUID_MARKER_1 in a text added with "--add-text" and "--var".
+Example:
+echo '{"cmd": "set", "var": "pseudo", "value": "Little Mouse"}' | guid --forms \
+ --control=stdin --add-entry="Type your pseudo" --var="pseudo")HEREDOC")) <<
+Help("", "") <<
+
 // --text
 Help("--text=\"Form label (form description)\"",
      QObject::tr("Set the form label (always displayed on top, and bold by default")) <<
@@ -396,6 +477,8 @@ guid --forms \
 To include information about the tab bar in values printed to the console, add the
 variable "verboseTabBar=true". Separators will be added in the output between tab
 fields and the selected tab will be marked with "*".)HEREDOC")) <<
+Help("--tab-visible",
+     QObject::tr("Show the tab added last when the dialog opens")) <<
 Help("", "") <<
 
 // --col1 || --col2
@@ -775,8 +858,8 @@ with ":/" followed by the resource name. For example, to use a "warning" icon:
 guid --forms \
  --add-text="image=:/warning@Text displayed"
 A marker named "GUID_MARKER_1" can be added in the text and it will be replaced by the file
-content specified with the variable "monitorMarkerFile1=Path to file". Up to 9 markers can
-be used (from GUID_MARKER_1 to GUID_MARKER_9). If the file content is empty, a default value
+content specified with the variable "monitorMarkerFile1=Path to file". Any number of markers
+can be used (GUID_MARKER_1, GUID_MARKER_2, etc.). If the file content is empty, a default value
 can be specified with the variable "defMarkerVal1=Value" (and "defMarkerVal2=Value",
 "defMarkerVal3=Value", etc.). Example:
 guid --forms \
@@ -856,8 +939,12 @@ Help("--add-text-info=\"[hideLabel=true@]Text info label\"",
 Note that this widget is a user input field only when the argument "--editable"
 is used. Otherwise, it's not a user input field, so it doesn't appear in the console
 (no even as empty value) when user input is printed.)HEREDOC")) <<
-Help("--filename=\"[monitor=true@]Path to file\"",
-     QObject::tr("Get content from the specified file")) <<
+Help("--filename=\"[monitor=true@][follow=true@]Path to file\"",
+     QObject::tr(R"HEREDOC(Get content from the specified file.
+To monitor file changes, add the variable "monitor=true". To follow a growing
+file like a log, add "follow=true" instead: only the lines appended to the file
+are read and added to the widget (the file is read again if it's truncated or
+replaced). In this mode, only the last MiB of the file is read at first.)HEREDOC")) <<
 Help("--url=URL", QObject::tr("Get content from the specified URL (curl must be installed on the system)")) <<
 Help("--curl-path=\"Path to curl\"",
      QObject::tr("Set path to the curl binary (default is \"curl\")")) <<
@@ -983,9 +1070,11 @@ Help("--footer-name=\"Footer name\"",
 Help("--footer-entries=\"Number of entries\"",
      QObject::tr(R"HEREDOC(Number of entries to display in the footer (most recent entries are always displayed first).
 Default is 3.)HEREDOC")) <<
-Help("--footer-from-file=\"[monitor=true@]Path to file\"",
+Help("--footer-from-file=\"[monitor=true@][follow=true@]Path to file\"",
      QObject::tr(R"HEREDOC(Use the file content as a source of footer entries.
-To monitor file changes, add the variable "monitor=true".)HEREDOC")) <<
+To monitor file changes, add the variable "monitor=true". To follow a growing
+file like a log, add "follow=true" instead: each line appended to the file
+becomes a new entry.)HEREDOC")) <<
 Help("", "") <<
 
 // Misc.
@@ -995,6 +1084,25 @@ Help("--forms-align=left|center|right",
      QObject::tr("Set label alignment for the entire form")) <<
 Help("--separator=SEPARATOR",
      QObject::tr("Set output separator character")) <<
+Help("--output-format=text|json|nul|shell",
+     QObject::tr(R"HEREDOC(Set the output format (default is "text", values joined by the separators).
+Each field is keyed by its variable name, or by "fieldN" (N counting the fields without
+a name). Check boxes print true or false and numbers are bare; list rows have their
+columns separated by tabs, except in JSON.
+- json: one object. List values are arrays of rows, each an array of columns. Tabs are
+  objects holding one object per tab, and groups are objects keyed by their title.
+- nul: "key=value" for each field, each terminated by a NUL character
+- shell: "key='value'" lines to be evaluated by the shell. Characters not allowed in
+  variable names are replaced by "_". List rows are separated by newlines.
+Example:
+eval "$(guid --forms --add-entry="Name" --var="name" --output-format=shell)")HEREDOC")) <<
+Help("--emit-changes[=MS]",
+     QObject::tr(R"HEREDOC(Print an event each time a field changes, before the dialog is closed.
+Each event is the field alone in the output format: "key=value" lines by default, or
+one-key JSON objects, NUL-terminated records or shell lines with "--output-format".
+Events of a field are debounced: one is printed once the field has been left unchanged
+for MS milliseconds (default is 100), with its latest value. When the reader is slow,
+the dialog does not wait for it: changes are merged and printed when it catches up.)HEREDOC")) <<
 Help("--comment=COMMENT",
      QObject::tr(R"HEREDOC(Add comment for convenience in the command line arguments.
 It'll be ignored when parsing arguments. Example:
@@ -1093,7 +1201,13 @@ beginning)HEREDOC")) <<
 Help("--field-height=HEIGHT",
      QObject::tr("Set the field height")) <<
 Help("--separator=SEPARATOR",
-     QObject::tr("Set output separator character")));
+     QObject::tr("Set output separator character")) <<
+Help("--output-format=text|json|nul|shell",
+     QObject::tr(R"HEREDOC(Set the output format (default is "text", rows joined by the separator).
+- json: an array of rows, each an array of columns
+- nul: rows terminated by a NUL character, their columns separated by tabs
+- shell: a single-quoted word holding the rows separated by newlines, their columns
+  separated by tabs. Example: eval "rows=$(guid --list ... --output-format=shell)")HEREDOC")));
 
 /******************************
  * notification
@@ -1145,7 +1259,9 @@ Help("--auto-close",
 Help("--auto-kill",
      QObject::tr("Kill parent process if Cancel button is pressed")) <<
 Help("--no-cancel",
-     QObject::tr("Hide Cancel button")));
+     QObject::tr("Hide Cancel button")) <<
+Help("--time-remaining",
+     QObject::tr("Show the estimated time remaining as a tooltip")));
 
 /******************************
  * question
@@ -1230,6 +1346,8 @@ Help("", "") <<
 
 Help("--auto-scroll",
      QObject::tr("Auto scroll the text to the end (only when text is captured from stdin)")) <<
+Help("--max-lines=N",
+     QObject::tr("Keep only the last N lines of text, dropping the oldest ones")) <<
 Help("--no-interaction",
      QObject::tr("Do not enable user interaction with the WebView (only when \"--html\" is used)")));
 
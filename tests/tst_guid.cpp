@@ -0,0 +1,125 @@
+/*
+ * Guid: Create advanced cross-platform GUI dialogs from the command line
+ *
+ * Checks of the functions of Guid.cpp that do not need a dialog. Guid.cpp is included
+ * whole, without its main(), so that its static functions can be called.
+ */
+
+#include <QBuffer>
+#include <QtTest>
+
+#define GUID_NO_MAIN
+#include "../Guid.cpp"
+
+class TestGuid : public QObject {
+	Q_OBJECT
+
+private slots:
+	void splitValuesLines();
+	void splitValuesSeparator();
+	void splitValuesLongInput();
+	void splitValuesUtf8();
+	void appendOutputTextJson();
+	void appendOutputTextShell();
+	void formsSpecReader();
+	void formsSpecReaderError();
+	void optionsHelp();
+	void benchmarkSplitValues();
+};
+
+static QStringList split(const QByteArray& data, const QByteArray& sep, bool trim = true) {
+	return splitValues(data.constData(), data.size(), sep, trim);
+}
+
+void TestGuid::splitValuesLines() {
+	QCOMPARE(split("a\nb\nc\n", "\n"), QStringList() << "a" << "b" << "c");
+	QCOMPARE(split("  a\r\n\r\nb  ", "\n"), QStringList() << "a" << "b"); // blank lines are skipped
+	QCOMPARE(split(" a \n", "\n", false), QStringList() << " a " << "");
+	QCOMPARE(split("", "\n"), QStringList() << "");
+}
+
+void TestGuid::splitValuesSeparator() {
+	QCOMPARE(split("a|b||c", "|"), QStringList() << "a" << "b" << "" << "c");
+	QCOMPARE(split("a::b:c", "::"), QStringList() << "a" << "b:c");
+	QCOMPARE(split("a|b\nc", "|"), QStringList() << "a" << "b" << "c"); // line breaks always split
+}
+
+void TestGuid::splitValuesLongInput() {
+	// Separators on both sides of the 16-byte blocks scanned at once
+	QStringList expected;
+	QByteArray data;
+	for (int i = 0; i < 100; ++i) {
+		const QByteArray value(i % 37, char('a' + i % 26));
+		expected << QString::fromLatin1(value);
+		data += value + ',';
+	}
+	data.chop(1);
+	QCOMPARE(split(data, ",", false), expected);
+}
+
+void TestGuid::splitValuesUtf8() {
+	const QString text = QString::fromUtf8("\xc3\xa9t\xc3\xa9|\xe2\x82\xac");
+	QCOMPARE(split(text.toUtf8(), "|"), QStringList() << QString::fromUtf8("\xc3\xa9t\xc3\xa9") << QString::fromUtf8("\xe2\x82\xac"));
+}
+
+void TestGuid::appendOutputTextJson() {
+	QString out;
+	appendOutputText(out, QString("a\"b\\c\nd\te") + QChar(1), OutputFormat::Json);
+	QCOMPARE(out, QString("\"a\\\"b\\\\c\\nd\\te\\u0001\""));
+}
+
+void TestGuid::appendOutputTextShell() {
+	QString out;
+	appendOutputText(out, "it's", OutputFormat::Shell);
+	QCOMPARE(out, QString("it'\\''s"));
+
+	out.clear();
+	appendOutputText(out, "a|b", OutputFormat::Text);
+	QCOMPARE(out, QString("a|b"));
+}
+
+void TestGuid::formsSpecReader() {
+	QByteArray spec = R"([
+		"forms",
+		{"text": "Title", "checked": true, "bold": false, "hide": null},
+		{"add-entry": {"var": "name", "text": "Name"}},
+		{"combo-values": ["a", "b"], "min-value": -2}
+	])";
+	QBuffer buffer(&spec);
+	buffer.open(QIODevice::ReadOnly);
+	FormsSpecReader reader(&buffer);
+	QStringList args;
+	QVERIFY2(reader.read(args), qPrintable(reader.errorString()));
+	QCOMPARE(args, QStringList() << "--forms" << "--text" << "Title" << "--checked"
+	                             << "--add-entry" << "var=name@Name" << "--combo-values" << "a|b"
+	                             << "--min-value" << "-2");
+}
+
+void TestGuid::formsSpecReaderError() {
+	QByteArray spec = "[\n\"forms\",\n{\"text\" \"Title\"}\n]";
+	QBuffer buffer(&spec);
+	buffer.open(QIODevice::ReadOnly);
+	FormsSpecReader reader(&buffer);
+	QStringList args;
+	QVERIFY(!reader.read(args));
+	QCOMPARE(reader.errorString(), QString("line 3: expected ':'"));
+}
+
+void TestGuid::optionsHelp() {
+	QCOMPARE(optionsWithoutHelp(), QStringList());
+}
+
+void TestGuid::benchmarkSplitValues() {
+	QByteArray data;
+	for (int i = 0; i < 100000; ++i)
+		data += "value " + QByteArray::number(i) + '\n';
+	QStringList values;
+	QBENCHMARK {
+		values = split(data, "\n");
+	}
+	QCOMPARE(values.count(), 100000);
+}
+
+QTEST_GUILESS_MAIN(TestGuid)
+
+#include "tst_guid.moc"